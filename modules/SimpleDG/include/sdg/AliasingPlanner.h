@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Assigns transient resources to shared memory slots, two resources can share a slot as long as they are never alive at the same time
+// Resources are placed largest first, each going into the first slot that is big enough and free for its whole lifetime
+struct TAliasingPlanner {
+
+    // The steps a resource is used between, a step is a position in a flat order or the index of a wave
+    struct Lifetime {
+        size_t first = SIZE_MAX;
+        size_t last = 0;
+
+        // Only resources that are written before they are read are created by the graph, anything else is kept from outside of it
+        bool isTransient = false;
+
+        bool isUsed() const { return first != SIZE_MAX; }
+
+        bool overlaps(const Lifetime& other) const { return first <= other.last && other.first <= last; }
+    };
+
+    struct Plan {
+        // Indexed by resource, SIZE_MAX for resources that are not transient
+        std::vector<size_t> slots;
+        std::vector<size_t> slotSizes;
+
+        // Bytes needed if every transient resource had its own memory
+        size_t unaliasedBytes = 0;
+        // Bytes needed by the slots, which is what the transient resources take when aliased
+        size_t aliasedBytes = 0;
+        // The most bytes alive during any one step, no plan can go below this
+        size_t peakLiveBytes = 0;
+    };
+
+    // Both are indexed by resource, a resource without a size is treated as taking no memory
+    Plan operator()(const std::vector<Lifetime>& lifetimes, const std::vector<size_t>& sizes) const {
+        const auto getSize = [&](const size_t resource) { return resource < sizes.size() ? sizes[resource] : 0; };
+
+        Plan plan;
+        plan.slots.assign(lifetimes.size(), SIZE_MAX);
+
+        std::vector<size_t> resources;
+        size_t lastStep = 0;
+        for (size_t resource = 0; resource < lifetimes.size(); ++resource) {
+            if (lifetimes[resource].isUsed() && lifetimes[resource].isTransient) {
+                resources.push_back(resource);
+                plan.unaliasedBytes += getSize(resource);
+                lastStep = std::max(lastStep, lifetimes[resource].last);
+            }
+        }
+
+        // Largest first, ties go to whichever is used first
+        std::sort(resources.begin(), resources.end(), [&](const size_t a, const size_t b) {
+            return getSize(a) != getSize(b) ? getSize(a) > getSize(b) : lifetimes[a].first < lifetimes[b].first;
+        });
+
+        // The resources placed in each slot
+        std::vector<std::vector<size_t>> slotResources;
+
+        for (const size_t resource : resources) {
+            size_t slot = 0;
+            for (; slot < slotResources.size(); ++slot) {
+                if (plan.slotSizes[slot] < getSize(resource))
+                    continue;
+
+                const bool isFree = std::none_of(slotResources[slot].begin(), slotResources[slot].end(), [&](const size_t other) {
+                    return lifetimes[resource].overlaps(lifetimes[other]);
+                });
+                if (isFree)
+                    break;
+            }
+
+            // Since larger resources are placed first, a new slot is always sized by the resource that made it
+            if (slot == slotResources.size()) {
+                slotResources.emplace_back();
+                plan.slotSizes.push_back(getSize(resource));
+                plan.aliasedBytes += getSize(resource);
+            }
+
+            slotResources[slot].push_back(resource);
+            plan.slots[resource] = slot;
+        }
+
+        // Add each resource at its first step and remove it after its last, then walk the steps
+        std::vector<int64_t> change(resources.empty() ? 0 : lastStep + 2, 0);
+        for (const size_t resource : resources) {
+            change[lifetimes[resource].first] += static_cast<int64_t>(getSize(resource));
+            change[lifetimes[resource].last + 1] -= static_cast<int64_t>(getSize(resource));
+        }
+
+        int64_t live = 0;
+        for (const int64_t bytes : change) {
+            live += bytes;
+            plan.peakLiveBytes = std::max(plan.peakLiveBytes, static_cast<size_t>(live));
+        }
+
+        return plan;
+    }
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+
+#ifdef USING_SIMPLESTL
+// Included first so the archive sees the containers, as it does in DependencyGraph.h
+#include "sutil/Hashing.h"
+#include "sstl/SmallVector.h"
+
+// Most nodes only have a few edges, so their lists are kept inline rather than each taking an allocation
+template <typename TType>
+using TAdjacencyList = TSmallVector<TType, 4>;
+#else
+template <typename TType>
+using TAdjacencyList = std::vector<TType>;
+#endif
+
+// A frozen form of the edges of a graph, stored as compressed sparse rows
+// The dependents of a node are edges[offsets[node]] up to edges[offsets[node + 1]], so looking them up needs no hashing,
+// and every edge of the graph sits in one contiguous array
+struct TCompressedDependencies {
+
+    TCompressedDependencies() = default;
+
+    TCompressedDependencies(const size_t nodeCount, const std::unordered_map<size_t, TAdjacencyList<size_t>>& dependencies) {
+        build(nodeCount, dependencies);
+    }
+
+    TCompressedDependencies(const size_t nodeCount, const std::vector<std::pair<size_t, size_t>>& edgeList) {
+        build(nodeCount, edgeList);
+    }
+
+    // Builds from a map of a node to its dependents, iterating the map directly so no node is looked up
+    // Throws if an edge refers to a node at or past nodeCount, leaving the rows empty
+    void build(const size_t nodeCount, const std::unordered_map<size_t, TAdjacencyList<size_t>>& dependencies) {
+        offsets.assign(nodeCount + 1, 0);
+
+        for (const auto& [node, dependents] : dependencies) {
+            if (node >= nodeCount || std::any_of(dependents.begin(), dependents.end(), [&](const size_t dependent) { return dependent >= nodeCount; }))
+                throwUnknownNode();
+            offsets[node + 1] = dependents.size();
+        }
+
+        for (size_t node = 0; node < nodeCount; ++node)
+            offsets[node + 1] += offsets[node];
+
+        edges.resize(offsets[nodeCount]);
+
+        for (const auto& [node, dependents] : dependencies)
+            std::copy(dependents.begin(), dependents.end(), edges.begin() + offsets[node]);
+    }
+
+    // Builds from a list of (node, dependent) pairs, the dependents of each node keep the order they were listed in
+    // Throws if an edge refers to a node at or past nodeCount, leaving the rows empty
+    void build(const size_t nodeCount, const std::vector<std::pair<size_t, size_t>>& edgeList) {
+        offsets.assign(nodeCount + 1, 0);
+
+        for (const auto& [node, dependent] : edgeList) {
+            if (node >= nodeCount || dependent >= nodeCount)
+                throwUnknownNode();
+            ++offsets[node + 1];
+        }
+
+        for (size_t node = 0; node < nodeCount; ++node)
+            offsets[node + 1] += offsets[node];
+
+        edges.resize(edgeList.size());
+
+        // Use the offset of the next node as a cursor, afterward it is shifted back to where it started
+        for (const auto& [node, dependent] : edgeList)
+            edges[offsets[node]++] = dependent;
+
+        for (size_t node = nodeCount; node > 0; --node)
+            offsets[node] = offsets[node - 1];
+        offsets[0] = 0;
+    }
+
+    void clear() {
+        offsets.clear();
+        edges.clear();
+    }
+
+    size_t getNodeCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    size_t getEdgeCount() const { return edges.size(); }
+
+    size_t getDependentCount(const size_t node) const { return offsets[node + 1] - offsets[node]; }
+
+    const size_t* getDependents(const size_t node) const { return edges.data() + offsets[node]; }
+
+    template <typename TFunc>
+    void forEachDependent(const size_t node, TFunc&& func) const {
+        for (size_t edge = offsets[node]; edge < offsets[node + 1]; ++edge)
+            func(edges[edge]);
+    }
+
+    // Bytes held by the offsets and edges, this is (nodes + 1 + edges) * sizeof(size_t) when not over-allocated
+    size_t getMemoryFootprint() const {
+        return (offsets.capacity() + edges.capacity()) * sizeof(size_t);
+    }
+
+    // An estimate of the bytes held by a map of a node to its dependents, not counting allocator overhead per allocation
+    // Each key holds a hash node and its own list, which has to allocate unless it is short enough to be kept inline
+    static size_t estimateMemoryFootprint(const std::unordered_map<size_t, TAdjacencyList<size_t>>& dependencies) {
+        size_t bytes = dependencies.bucket_count() * sizeof(void*);
+        for (const auto& [node, dependents] : dependencies) {
+            // The pair itself, plus the next pointer and cached hash held by each hash node
+            bytes += sizeof(std::pair<const size_t, TAdjacencyList<size_t>>) + sizeof(void*) + sizeof(size_t);
+#ifdef USING_SIMPLESTL
+            // Short lists are held by the pair, which has already been counted
+            if (dependents.isInline()) continue;
+#endif
+            bytes += dependents.capacity() * sizeof(size_t);
+        }
+        return bytes;
+    }
+
+    std::vector<size_t> offsets;
+    std::vector<size_t> edges;
+
+private:
+
+    void throwUnknownNode() {
+        clear();
+        throw std::runtime_error("Dependency refers to a node that does not exist!");
+    }
+};
@@ -1,17 +1,48 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <queue>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 #include <map>
-#include <unordered_set>
-#include <queue>
 #include "sutil/Hashing.h"
+#include "CompressedDependencies.h"
+#include "TransitiveReduction.h"
+#include "AliasingPlanner.h"
 
 #ifdef USING_SIMPLESTL
 #include "sstl/Vector.h"
 #endif
 
+// An incremental sorter keeps its order up to date as the graph changes, rather than sorting it from scratch
+#if CXX_VERSION >= 20
+template <typename TTopologicalSorter>
+concept is_incremental_sorter_v = requires(TTopologicalSorter sorter, size_t node) {
+    sorter.onAddNode(node);
+    sorter.onAddDependency(node, node);
+    sorter.onRemoveDependency(node, node);
+};
+#else
+template <typename TTopologicalSorter, typename = void>
+struct is_incremental_sorter : std::false_type {};
+
+template <typename TTopologicalSorter>
+struct is_incremental_sorter
+<TTopologicalSorter,
+    std::void_t<
+        decltype(std::declval<TTopologicalSorter&>().onAddNode(size_t{})),
+        decltype(std::declval<TTopologicalSorter&>().onAddDependency(size_t{}, size_t{})),
+        decltype(std::declval<TTopologicalSorter&>().onRemoveDependency(size_t{}, size_t{}))
+    >
+>: std::true_type {};
+
+template <typename TTopologicalSorter>
+constexpr bool is_incremental_sorter_v = is_incremental_sorter<TTopologicalSorter>::value;
+#endif
+
 template <typename TType, typename TTopologicalSorter>
 struct TDependencyGraph {
 
@@ -20,20 +51,40 @@ struct TDependencyGraph {
     TType& getNode(size_t id) { return nodes[id]; }
     const TType& getNode(size_t id) const { return nodes[id]; }
 
+    size_t getNodeCount() const { return nodes.size(); }
+
+    // Only given out as const, so a sorter can't be changed without the graph knowing its order has to be rebuilt
+    const TTopologicalSorter& getSorter() const { return sorter; }
+
+    // For sorters that take costs, such as TCriticalPathSort, the order is rebuilt with them on the next build
+    template <typename TCostEstimator>
+    void setCostEstimator(TCostEstimator&& costEstimator) {
+        sorter.setCostEstimator(std::forward<TCostEstimator>(costEstimator));
+        onSorterChanged();
+    }
+
     template <typename... TArgs>
     size_t addNode(TArgs&&... args) {
         const size_t nodeId = nodes.size();
         nodes.emplace_back(std::forward<TArgs>(args)...);
+        if constexpr (is_incremental_sorter_v<TTopologicalSorter>) {
+            sorter.onAddNode(nodeId);
+        }
         return nodeId;
     }
 
-#ifdef USING_SIMPLESTL
-    virtual TVector<size_t> buildExecutionOrder() = 0;
-#else
-    virtual std::vector<size_t> buildExecutionOrder() = 0;
-#endif
+    // Returns the edges of the graph, a node must run before each of its dependents
+    virtual const TCompressedDependencies& buildDependencies() = 0;
+
+    // The type of order depends on the sorter, such as a flat list of nodes or a list of waves
+    // The order is kept by the graph, so the reference is only valid until the graph changes or is built again
+    virtual const typename TTopologicalSorter::OrderType& buildExecutionOrder() = 0;
+
 protected:
 
+    // Drops whatever order the graph has kept, as the sorter would now sort differently
+    virtual void onSorterChanged() = 0;
+
     std::vector<TType> nodes;
     TTopologicalSorter sorter;
 };
@@ -45,21 +96,77 @@ struct TSimpleDependencyGraph : TDependencyGraph<TType, TTopologicalSorter> {
     using TDependencyGraph<TType, TTopologicalSorter>::nodes;
     using TDependencyGraph<TType, TTopologicalSorter>::sorter;
 
+    // An incremental sorter will throw if this would make a cycle or either node does not exist, in which case the dependency is not added
     void addDependency(const size_t node, const size_t dependency) {
+        if constexpr (is_incremental_sorter_v<TTopologicalSorter>) {
+            sorter.onAddDependency(node, dependency);
+        }
         dependencies[node].push_back(dependency);
+        isCompiled = false;
+        isOrdered = false;
     }
 
-#ifdef USING_SIMPLESTL
-    virtual TVector<size_t> buildExecutionOrder() override {
-#else
-    virtual std::vector<size_t> buildExecutionOrder() override {
-#endif
-        return sorter(nodes, dependencies);
+    // Removes one dependency between the two nodes, returns false if there was none
+    bool removeDependency(const size_t node, const size_t dependency) {
+        const auto found = dependencies.find(node);
+        if (found == dependencies.end()) return false;
+
+        TAdjacencyList<size_t>& dependents = found->second;
+        const auto edge = std::find(dependents.begin(), dependents.end(), dependency);
+        if (edge == dependents.end()) return false;
+
+        dependents.erase(edge);
+        if (dependents.empty())
+            dependencies.erase(found);
+
+        if constexpr (is_incremental_sorter_v<TTopologicalSorter>) {
+            sorter.onRemoveDependency(node, dependency);
+        }
+        isCompiled = false;
+        isOrdered = false;
+        return true;
+    }
+
+    // Compiles the dependencies into compressed rows, which are kept until the graph changes
+    virtual const TCompressedDependencies& buildDependencies() override {
+        if (!isCompiled || compiledDependencies.getNodeCount() != nodes.size()) {
+            compiledDependencies.build(nodes.size(), dependencies);
+            isCompiled = true;
+        }
+        return compiledDependencies;
+    }
+
+    // Like the compiled dependencies, the order is kept until the graph changes
+    virtual const typename TTopologicalSorter::OrderType& buildExecutionOrder() override {
+        if (!isOrdered || orderedNodeCount != nodes.size()) {
+            // The incremental sorter already has the order, so the dependencies do not need compiling
+            if constexpr (is_incremental_sorter_v<TTopologicalSorter>) {
+                order = sorter.getOrder();
+            } else {
+                order = sorter(nodes, buildDependencies());
+            }
+            orderedNodeCount = nodes.size();
+            isOrdered = true;
+        }
+        return order;
+    }
+
+protected:
+
+    virtual void onSorterChanged() override {
+        isOrdered = false;
     }
 
 private:
 
-    std::unordered_map<size_t, std::vector<size_t>> dependencies;
+    std::unordered_map<size_t, TAdjacencyList<size_t>> dependencies;
+
+    TCompressedDependencies compiledDependencies;
+    bool isCompiled = false;
+
+    typename TTopologicalSorter::OrderType order;
+    size_t orderedNodeCount = 0;
+    bool isOrdered = false;
 };
 
 // Read and Write dependencies
@@ -67,64 +174,218 @@ template <typename TType, typename TDependencyType, typename TTopologicalSorter>
 struct TRWDependencyGraph : TDependencyGraph<TType, TTopologicalSorter> {
 
     struct Access {
-        size_t node;
+        // The dense index of the resource, see getResourceIndex
+        size_t resource;
         enum { READ, WRITE } type;
     };
 
     using TDependencyGraph<TType, TTopologicalSorter>::nodes;
     using TDependencyGraph<TType, TTopologicalSorter>::sorter;
 
+    // Dependencies are only derived when building, so there are no changes to report to an incremental sorter
+    static_assert(!is_incremental_sorter_v<TTopologicalSorter>, "TRWDependencyGraph does not support incremental sorters!");
+
+    // Both throw if the node has not been added, before the resource is given an index
     void addRead(size_t node, const TDependencyType& dependency) {
-        if constexpr (sutil::is_hashable_v<TDependencyType>) {
-            dependencies[node].emplace_back(Access{getHash(dependency), Access::READ});
-        } else {
-    		std::hash<TDependencyType> hashValue;
-            dependencies[node].emplace_back(Access{hashValue(dependency), Access::READ});
-        }
+        TAdjacencyList<Access>& accesses = getAccesses(node);
+        accesses.emplace_back(Access{getResourceIndex(dependency), Access::READ});
     }
 
     void addWrite(size_t node, const TDependencyType& dependency) {
+        TAdjacencyList<Access>& accesses = getAccesses(node);
+        accesses.emplace_back(Access{getResourceIndex(dependency), Access::WRITE});
+    }
+
+    // Resources are given a dense index the first time they are accessed, so their state can be kept in flat arrays
+    size_t getResourceIndex(const TDependencyType& dependency) {
+        size_t hash;
         if constexpr (sutil::is_hashable_v<TDependencyType>) {
-            dependencies[node].emplace_back(Access{getHash(dependency), Access::WRITE});
+            hash = getHash(dependency);
         } else {
             std::hash<TDependencyType> hashValue;
-            dependencies[node].emplace_back(Access{hashValue(dependency), Access::WRITE});
+            hash = hashValue(dependency);
         }
+        return resourceIndices.try_emplace(hash, resourceIndices.size()).first->second;
     }
 
-#ifdef USING_SIMPLESTL
-    virtual TVector<size_t> buildExecutionOrder() override {
-#else
-    virtual std::vector<size_t> buildExecutionOrder() override {
-#endif
-        std::unordered_map<size_t, std::vector<size_t>> outDependencies;
+    size_t getResourceCount() const { return resourceIndices.size(); }
 
-        struct ResourceState {
-            size_t lastWriter = SIZE_MAX;
-           std::unordered_set<size_t> lastReaders;
-        };
+    struct ExecutionPlan {
+        TCompressedDependencies dependencies;
+        typename TTopologicalSorter::OrderType order;
+
+        // The amount of edges derived from the accesses, before any were removed by transitive reduction
+        size_t derivedEdgeCount = 0;
+
+        // Indexed by resource, the steps are positions in the order, or the index of the wave for sorters that return waves
+        std::vector<TAliasingPlanner::Lifetime> resourceLifetimes;
+    };
 
-        std::unordered_map<size_t, ResourceState> resourceStates;
+    // Plans are cached by the accesses they were derived from, so replaying the same accesses returns the same plan without allocating
+    // The returned plan stays valid until it is evicted, which only happens to the least recently used plan on a miss once the cache is full, or until the cache is cleared
+    const ExecutionPlan& buildExecutionPlan() {
+        // Nodes without any accesses still need an entry, so every node is visited in order
+        if (dependencies.size() < nodes.size())
+            dependencies.resize(nodes.size());
+
+        // The accesses are public, so entries past the last node would otherwise derive edges to nodes that do not exist
+        if (dependencies.size() > nodes.size())
+            throw std::runtime_error("Dependency refers to a node that does not exist!");
+
+        const size_t hash = hashAccesses();
+
+        // Accesses that share a hash each keep their own plan
+        const auto [first, last] = planCache.equal_range(hash);
+        for (auto found = first; found != last; ++found) {
+            if (matchesAccesses(found->second.accesses)) {
+                ++planCacheHits;
+                found->second.lastUsed = ++planCacheUses;
+                return found->second.plan;
+            }
+        }
+
+        ++planCacheMisses;
+
+        // Built on its own and only cached once it succeeds, so a throw leaves every cached plan as it was
+        CachedPlan cached;
+        flattenAccesses(cached.accesses);
+        deriveEdges();
+        cached.plan.dependencies.build(nodes.size(), edgeList);
+        cached.plan.derivedEdgeCount = edgeList.size();
+        if (useTransitiveReduction)
+            transitiveReduction(cached.plan.dependencies);
+        auto order = sorter(nodes, cached.plan.dependencies);
+        assignSteps(order);
+        buildResourceLifetimes(cached.plan.resourceLifetimes);
+        cached.plan.order = std::move(order);
+        cached.lastUsed = ++planCacheUses;
+
+        // Plans for accesses that are no longer used would otherwise pile up, only the oldest is evicted so the others stay valid
+        while (planCache.size() >= planCacheCapacity) {
+            const auto oldest = std::min_element(planCache.begin(), planCache.end(), [](const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+            planCache.erase(oldest);
+        }
+
+        return planCache.emplace(hash, std::move(cached))->second.plan;
+    }
+
+    virtual const TCompressedDependencies& buildDependencies() override {
+        return buildExecutionPlan().dependencies;
+    }
+
+    virtual const typename TTopologicalSorter::OrderType& buildExecutionOrder() override {
+        return buildExecutionPlan().order;
+    }
+
+    // Sizes are indexed by resource, see getResourceIndex, the lifetimes assume each step finishes before the next starts
+    TAliasingPlanner::Plan buildAliasingPlan(const std::vector<size_t>& sizes) {
+        return TAliasingPlanner()(buildExecutionPlan().resourceLifetimes, sizes);
+    }
+
+    size_t getPlanCacheHits() const { return planCacheHits; }
+    size_t getPlanCacheMisses() const { return planCacheMisses; }
+
+    void setPlanCacheCapacity(const size_t capacity) { planCacheCapacity = capacity > 0 ? capacity : 1; }
+
+    void clearPlanCache() { planCache.clear(); }
+
+    // Every reader before a writer gets an edge, along with each writer after another, many of which are implied by other edges
+    // When enabled, those edges are removed before sorting, compare derivedEdgeCount to the plan's edge count to see how many
+    void setTransitiveReduction(const bool enabled, const size_t maxNodeCount = 16384) {
+        useTransitiveReduction = enabled;
+        transitiveReduction.maxNodeCount = maxNodeCount;
+        clearPlanCache();
+    }
 
-        for (const auto& [node, accesses] : dependencies) {
+    // The accesses of each node, in the order they were added
+    std::vector<TAdjacencyList<Access>> dependencies;
+
+protected:
+
+    // Plans are only keyed by the accesses, so ones sorted the old way can't be told apart
+    virtual void onSorterChanged() override {
+        clearPlanCache();
+    }
+
+private:
+
+    struct CachedPlan {
+        // The accesses the plan was derived from, laid out as the node count, then for each node its access count and a resource and type for each access
+        // Kept so two sets of accesses that share a hash are never mistaken for one another
+        std::vector<size_t> accesses;
+        ExecutionPlan plan;
+        // When the plan was last built or returned, the smallest is evicted first
+        size_t lastUsed = 0;
+    };
+
+    size_t hashAccesses() const {
+        CHashArchive archive;
+        archive << nodes.size();
+        for (const auto& accesses : dependencies) {
+            archive << accesses.size();
+            for (const auto& access : accesses)
+                archive << access.resource << static_cast<size_t>(access.type);
+        }
+        return archive.get();
+    }
+
+    void flattenAccesses(std::vector<size_t>& outAccesses) const {
+        outAccesses.clear();
+        outAccesses.push_back(nodes.size());
+        for (const auto& accesses : dependencies) {
+            outAccesses.push_back(accesses.size());
             for (const auto& access : accesses) {
-                ResourceState& currentResourceState = resourceStates[access.node];
+                outAccesses.push_back(access.resource);
+                outAccesses.push_back(static_cast<size_t>(access.type));
+            }
+        }
+    }
+
+    bool matchesAccesses(const std::vector<size_t>& inAccesses) const {
+        size_t index = 0;
+        const auto next = [&](const size_t value) { return index < inAccesses.size() && inAccesses[index++] == value; };
+
+        if (!next(nodes.size())) return false;
+        for (const auto& accesses : dependencies) {
+            if (!next(accesses.size())) return false;
+            for (const auto& access : accesses)
+                if (!next(access.resource) || !next(static_cast<size_t>(access.type))) return false;
+        }
+        return index == inAccesses.size();
+    }
+
+    // Derives the edges between nodes from the order they access each resource, visiting the nodes in the order they were added
+    void deriveEdges() {
+        edgeList.clear();
+
+        // Reset rather than reallocated, the readers keep the memory they grew to
+        resourceStates.resize(resourceIndices.size());
+        for (auto& resourceState : resourceStates) {
+            resourceState.lastWriter = SIZE_MAX;
+            resourceState.lastReaders.clear();
+        }
+
+        for (size_t node = 0; node < dependencies.size(); ++node) {
+            for (const auto& access : dependencies[node]) {
+                ResourceState& currentResourceState = resourceStates[access.resource];
 
                 switch (access.type) {
                 case Access::READ:
                     // RAW - When reading from a resource, the last one who wrote to it must run first
                     if (currentResourceState.lastWriter != SIZE_MAX && currentResourceState.lastWriter != node)
-                        outDependencies[currentResourceState.lastWriter].emplace_back(node);
-                    currentResourceState.lastReaders.emplace(node);
+                        edgeList.emplace_back(currentResourceState.lastWriter, node);
+                    // Nodes are visited in order, so a node reading the same resource twice is always the last reader
+                    if (currentResourceState.lastReaders.empty() || currentResourceState.lastReaders.back() != node)
+                        currentResourceState.lastReaders.push_back(node);
                     break;
                 case Access::WRITE:
                     // WAW - When writing to a resource, we must wait on the previous writer before writing to it
                     if (currentResourceState.lastWriter != SIZE_MAX && currentResourceState.lastWriter != node)
-                        outDependencies[currentResourceState.lastWriter].emplace_back(node);
+                        edgeList.emplace_back(currentResourceState.lastWriter, node);
                     // WAR - When writing to a resource, we must wait on the previous readers before writing to it, as to not change it while reading
                     for (size_t reader : currentResourceState.lastReaders)
                         if (reader != node)
-                            outDependencies[reader].emplace_back(node);
+                            edgeList.emplace_back(reader, node);
                     currentResourceState.lastReaders.clear();
                     currentResourceState.lastWriter = node;
                     break;
@@ -132,11 +393,84 @@ struct TRWDependencyGraph : TDependencyGraph<TType, TTopologicalSorter> {
                 }
             }
         }
+    }
+
+    void assignSteps(const std::vector<size_t>& order) {
+        steps.resize(nodes.size());
+        for (size_t index = 0; index < order.size(); ++index)
+            steps[order[index]] = index;
+    }
+
+    void assignSteps(const std::vector<std::vector<size_t>>& waves) {
+        steps.resize(nodes.size());
+        for (size_t index = 0; index < waves.size(); ++index)
+            for (const size_t node : waves[index])
+                steps[node] = index;
+    }
+
+#ifdef USING_SIMPLESTL
+    void assignSteps(const TVector<TVector<size_t>>& waves) {
+        steps.resize(nodes.size());
+        waves.forEach([&](const size_t index, const TVector<size_t>& wave) {
+            wave.forEach([&](size_t, const size_t& node) {
+                steps[node] = index;
+            });
+        });
+    }
+#endif
+
+    // A resource lives from the first step that uses it until the last
+    void buildResourceLifetimes(std::vector<TAliasingPlanner::Lifetime>& outLifetimes) const {
+        outLifetimes.assign(resourceIndices.size(), TAliasingPlanner::Lifetime{});
+
+        for (size_t node = 0; node < dependencies.size(); ++node) {
+            const size_t step = steps[node];
+            for (const auto& access : dependencies[node]) {
+                TAliasingPlanner::Lifetime& lifetime = outLifetimes[access.resource];
+
+                // The first access of the first node to use it decides if it is made by the graph
+                if (step < lifetime.first) {
+                    lifetime.first = step;
+                    lifetime.isTransient = access.type == Access::WRITE;
+                }
+                lifetime.last = std::max(lifetime.last, step);
+            }
+        }
+    }
 
-        return sorter(nodes, outDependencies);
+    TAdjacencyList<Access>& getAccesses(const size_t node) {
+        if (node >= nodes.size())
+            throw std::runtime_error("Dependency refers to a node that does not exist!");
+        if (node >= dependencies.size())
+            dependencies.resize(node + 1);
+        return dependencies[node];
     }
 
-    std::unordered_map<size_t, std::vector<Access>> dependencies;
+    struct ResourceState {
+        size_t lastWriter = SIZE_MAX;
+        TAdjacencyList<size_t> lastReaders;
+    };
+
+    // Maps the hash of a resource to its dense index
+    std::unordered_map<size_t, size_t> resourceIndices;
+
+    // Indexed by resource
+    std::vector<ResourceState> resourceStates;
+
+    // The step each node runs in, from the last order that was sorted
+    std::vector<size_t> steps;
+
+    // Reused between misses so deriving a plan does not have to grow it again
+    std::vector<std::pair<size_t, size_t>> edgeList;
+
+    std::unordered_multimap<size_t, CachedPlan> planCache;
+    size_t planCacheCapacity = 8;
+    size_t planCacheUses = 0;
+    size_t planCacheHits = 0;
+    size_t planCacheMisses = 0;
+
+    bool useTransitiveReduction = false;
+    TTransitiveReduction transitiveReduction;
 };
 
 
@@ -144,47 +478,416 @@ struct TRWDependencyGraph : TDependencyGraph<TType, TTopologicalSorter> {
 // Essentially uses a brute force approach, calculating dependents one by one, despite this, it is quite fast and space efficient
 struct TKahnTopologicalSort {
 
-    template <typename TType>
-    std::vector<size_t> operator()(const std::vector<TType>& nodes, const std::unordered_map<size_t, std::vector<size_t>>& dependencies) const {
-        std::vector<int> inDegree;
+#ifdef USING_SIMPLESTL
+    using OrderType = TVector<size_t>;
+#else
+    using OrderType = std::vector<size_t>;
+#endif
 
+    // Calculates the amount of nodes each node is waiting on, a node that nothing depends on will be 0
+    static std::vector<int> calculateInDegree(const TCompressedDependencies& dependencies) {
         // Each node starts with 0 dependencies
-        for (size_t i = 0; i < nodes.size(); ++i)
-            inDegree.push_back(0);
+        std::vector<int> inDegree(dependencies.getNodeCount(), 0);
+
+        // Add one whenever a node is a dependency
+        for (const size_t to : dependencies.edges)
+            ++inDegree[to];
 
-        // Add one whenever a node is a dependency, a node that nothing depends on will be 0
-        for (size_t i = 0; i < nodes.size(); ++i)
-            if (dependencies.find(i) != dependencies.end())
-                for (size_t to : dependencies.at(i))
-                    ++inDegree[to];
+        return inDegree;
+    }
+
+    template <typename TType>
+    std::vector<size_t> operator()(const std::vector<TType>& nodes, const std::unordered_map<size_t, TAdjacencyList<size_t>>& dependencies) const {
+        return (*this)(nodes, TCompressedDependencies(nodes.size(), dependencies));
+    }
+
+    template <typename TType>
+    std::vector<size_t> operator()(const std::vector<TType>& nodes, const TCompressedDependencies& dependencies) const {
+        std::vector<size_t> order = sort(dependencies);
+
+        if (order.size() != nodes.size())
+            throw std::runtime_error("Cycle detected in dependency graph!");
+
+        return order;
+    }
+
+    // Sorts every node of the dependencies, for when there are no nodes to go with them
+    static std::vector<size_t> sort(const TCompressedDependencies& dependencies) {
+        std::vector<int> inDegree = calculateInDegree(dependencies);
+
+        // The order doubles as the queue, everything past the front has no dependencies left but has not been visited
+        std::vector<size_t> order;
+        order.reserve(dependencies.getNodeCount());
 
         // Each node that nothing depends on will be added to queue
-        std::queue<size_t> q;
         for (size_t id = 0; id < inDegree.size(); ++id)
             if (inDegree[id] == 0)
-                q.push(id);
+                order.push_back(id);
 
-        std::vector<size_t> order;
+        for (size_t front = 0; front < order.size(); ++front) {
+
+            // For each node that is no longer a dependent, add to the queue
+            dependencies.forEachDependent(order[front], [&](const size_t dependency) {
+                if (--inDegree[dependency] == 0) {
+                    order.push_back(dependency);
+                }
+            });
+        }
 
-        while (!q.empty()) {
+        if (order.size() != dependencies.getNodeCount())
+            throw std::runtime_error("Cycle detected in dependency graph!");
 
-            // Push the nodes with no dependencies into the list
-            size_t id = q.front(); q.pop();
-            order.push_back(id);
+        return order;
+    }
+};
 
-            // For each node that is no longer a dependent, add to the queue
-            if (dependencies.find(id) != dependencies.end()) {
-                for (auto& dependency : dependencies.at(id)) {
+// Sorts the nodes into waves, where each wave only depends on nodes in earlier waves
+// Every node within a wave can be run at the same time, so each wave can be dispatched as one batch
+struct TKahnWavefrontSort {
+
+#ifdef USING_SIMPLESTL
+    using OrderType = TVector<TVector<size_t>>;
+#else
+    using OrderType = std::vector<std::vector<size_t>>;
+#endif
+
+    template <typename TType>
+    OrderType operator()(const std::vector<TType>& nodes, const std::unordered_map<size_t, TAdjacencyList<size_t>>& dependencies) const {
+        return (*this)(nodes, TCompressedDependencies(nodes.size(), dependencies));
+    }
+
+    template <typename TType>
+    OrderType operator()(const std::vector<TType>& nodes, const TCompressedDependencies& dependencies) const {
+        std::vector<int> inDegree = TKahnTopologicalSort::calculateInDegree(dependencies);
+
+        // The first wave is each node that nothing depends on
+        std::vector<size_t> wave;
+        for (size_t id = 0; id < inDegree.size(); ++id)
+            if (inDegree[id] == 0)
+                wave.push_back(id);
+
+        OrderType waves;
+        size_t sortedCount = 0;
+
+        while (!wave.empty()) {
+            std::vector<size_t> nextWave;
+
+            // Any node whose last dependency is in this wave belongs to the next one
+            for (const size_t id : wave) {
+                dependencies.forEachDependent(id, [&](const size_t dependency) {
                     if (--inDegree[dependency] == 0) {
-                        q.push(dependency);
+                        nextWave.push_back(dependency);
                     }
+                });
+            }
+
+            sortedCount += wave.size();
+#ifdef USING_SIMPLESTL
+            waves.push(TVector<size_t>(wave));
+#else
+            waves.push_back(std::move(wave));
+#endif
+            wave = std::move(nextWave);
+        }
+
+        if (sortedCount != nodes.size())
+            throw std::runtime_error("Cycle detected in dependency graph!");
+
+        return waves;
+    }
+};
+
+// Keeps a topological order between changes to the graph, based on the algorithm by Pearce and Kelly
+// Adding a dependency that breaks the order only reorders the nodes between the two ends of it, and removing one never breaks it
+// Best for graphs that are rebuilt often with only a few changes, as it has to keep its own copy of the edges
+struct TIncrementalTopologicalSort {
+
+#ifdef USING_SIMPLESTL
+    using OrderType = TVector<size_t>;
+#else
+    using OrderType = std::vector<size_t>;
+#endif
+
+    void onAddNode(const size_t node) {
+        if (node >= position.size()) {
+            position.resize(node + 1, SIZE_MAX);
+            dependents.resize(node + 1);
+            dependencies.resize(node + 1);
+            visited.resize(node + 1, false);
+        }
+        position[node] = order.size();
+        order.push_back(node);
+    }
+
+    void onAddDependency(const size_t node, const size_t dependency) {
+        // Only nodes reported through onAddNode have a position
+        if (node >= position.size() || dependency >= position.size() || position[node] == SIZE_MAX || position[dependency] == SIZE_MAX)
+            throw std::runtime_error("Dependency refers to a node that does not exist!");
+
+        if (node == dependency)
+            throw std::runtime_error("Cycle detected in dependency graph!");
+
+        const size_t lowerBound = position[dependency];
+        const size_t upperBound = position[node];
+
+        // The order is only broken if the dependency currently comes first
+        if (lowerBound < upperBound) {
+            // Everything reachable from the dependency that comes before the node, reaching the node would close a cycle
+            if (!search(dependency, upperBound, true, forwardRegion)) {
+                resetVisited(forwardRegion);
+                throw std::runtime_error("Cycle detected in dependency graph!");
+            }
+
+            // Everything that reaches the node and comes after the dependency
+            search(node, lowerBound, false, backwardRegion);
+
+            reorder();
+        }
+
+        dependents[node].push_back(dependency);
+        dependencies[dependency].push_back(node);
+    }
+
+    void onRemoveDependency(const size_t node, const size_t dependency) {
+        removeOne(dependents[node], dependency);
+        removeOne(dependencies[dependency], node);
+    }
+
+    const std::vector<size_t>& getOrder() const { return order; }
+
+    // Sorts from scratch and starts tracking the given graph, for when the changes have not been reported
+    template <typename TType>
+    std::vector<size_t> operator()(const std::vector<TType>& nodes, const TCompressedDependencies& inDependencies) {
+        order = TKahnTopologicalSort()(nodes, inDependencies);
+
+        position.assign(nodes.size(), 0);
+        for (size_t index = 0; index < order.size(); ++index)
+            position[order[index]] = index;
+
+        dependents.assign(nodes.size(), {});
+        dependencies.assign(nodes.size(), {});
+        visited.assign(nodes.size(), false);
+        for (size_t node = 0; node < nodes.size(); ++node) {
+            inDependencies.forEachDependent(node, [&](const size_t dependency) {
+                dependents[node].push_back(dependency);
+                dependencies[dependency].push_back(node);
+            });
+        }
+
+        return order;
+    }
+
+    template <typename TType>
+    std::vector<size_t> operator()(const std::vector<TType>& nodes, const std::unordered_map<size_t, TAdjacencyList<size_t>>& inDependencies) {
+        return (*this)(nodes, TCompressedDependencies(nodes.size(), inDependencies));
+    }
+
+private:
+
+    // Depth first search that stays within the bound, returns false if the search went forward and reached the bound itself
+    bool search(const size_t start, const size_t bound, const bool forward, std::vector<size_t>& outRegion) {
+        outRegion.clear();
+        stack.clear();
+
+        stack.push_back(start);
+        visited[start] = true;
+
+        while (!stack.empty()) {
+            const size_t current = stack.back();
+            stack.pop_back();
+            outRegion.push_back(current);
+
+            for (const size_t next : forward ? dependents[current] : dependencies[current]) {
+                if (forward && position[next] == bound) {
+                    // Keep whatever is left on the stack in the region, so it can be unmarked
+                    outRegion.insert(outRegion.end(), stack.begin(), stack.end());
+                    return false;
+                }
+
+                const bool inRegion = forward ? position[next] < bound : position[next] > bound;
+                if (inRegion && !visited[next]) {
+                    visited[next] = true;
+                    stack.push_back(next);
                 }
             }
         }
+        return true;
+    }
+
+    // Moves the nodes that reach the node ahead of the nodes reachable from the dependency, reusing the positions they held
+    void reorder() {
+        const auto byPosition = [&](const size_t a, const size_t b) { return position[a] < position[b]; };
+        std::sort(backwardRegion.begin(), backwardRegion.end(), byPosition);
+        std::sort(forwardRegion.begin(), forwardRegion.end(), byPosition);
+
+        positions.clear();
+        for (const size_t node : backwardRegion) positions.push_back(position[node]);
+        for (const size_t node : forwardRegion) positions.push_back(position[node]);
+        std::sort(positions.begin(), positions.end());
+
+        size_t index = 0;
+        for (const size_t node : backwardRegion) place(node, positions[index++]);
+        for (const size_t node : forwardRegion) place(node, positions[index++]);
+
+        resetVisited(backwardRegion);
+        resetVisited(forwardRegion);
+    }
+
+    void place(const size_t node, const size_t index) {
+        position[node] = index;
+        order[index] = node;
+    }
+
+    void resetVisited(const std::vector<size_t>& region) {
+        for (const size_t node : region)
+            visited[node] = false;
+    }
+
+    static void removeOne(TAdjacencyList<size_t>& list, const size_t value) {
+        const auto found = std::find(list.begin(), list.end(), value);
+        if (found != list.end())
+            list.erase(found);
+    }
+
+    std::vector<size_t> order;
+    std::vector<size_t> position;
+
+    // Both directions of each edge, as the search has to walk backwards from the node
+    std::vector<TAdjacencyList<size_t>> dependents;
+    std::vector<TAdjacencyList<size_t>> dependencies;
+
+    // Reused between changes, so repairing the order does not allocate once they have grown
+    std::vector<bool> visited;
+    std::vector<size_t> stack;
+    std::vector<size_t> forwardRegion;
+    std::vector<size_t> backwardRegion;
+    std::vector<size_t> positions;
+};
+
+// Orders the ready nodes by the longest path of estimated cost left after them, so the chains that hold up the end are started first
+// When the order is handed to a fixed amount of workers, this keeps them busy for longer than the order Kahn visits nodes in
+struct TCriticalPathSort {
+
+#ifdef USING_SIMPLESTL
+    using OrderType = TVector<size_t>;
+#else
+    using OrderType = std::vector<size_t>;
+#endif
+
+    using TCostEstimator = std::function<double(size_t)>;
+
+    // Every node costs the same by default, which favors the nodes with the most dependents after them
+    void setCostEstimator(TCostEstimator inCostEstimator) { costEstimator = std::move(inCostEstimator); }
+
+    double getCost(const size_t node) const { return costEstimator ? costEstimator(node) : 1.0; }
+
+    // The cost of a node plus the most expensive path through its dependents
+    std::vector<double> calculateRanks(const TCompressedDependencies& dependencies) const {
+        const size_t nodeCount = dependencies.getNodeCount();
+
+        // Any order will do, it is only walked backwards so dependents are ranked first
+        const std::vector<size_t> order = TKahnTopologicalSort::sort(dependencies);
+
+        std::vector<double> ranks(nodeCount, 0.0);
+        for (size_t index = nodeCount; index > 0; --index) {
+            const size_t node = order[index - 1];
+            double longest = 0.0;
+            dependencies.forEachDependent(node, [&](const size_t dependency) {
+                longest = std::max(longest, ranks[dependency]);
+            });
+            ranks[node] = getCost(node) + longest;
+        }
+        return ranks;
+    }
+
+    template <typename TType>
+    std::vector<size_t> operator()(const std::vector<TType>& nodes, const std::unordered_map<size_t, TAdjacencyList<size_t>>& dependencies) const {
+        return (*this)(nodes, TCompressedDependencies(nodes.size(), dependencies));
+    }
+
+    template <typename TType>
+    std::vector<size_t> operator()(const std::vector<TType>& nodes, const TCompressedDependencies& dependencies) const {
+        const std::vector<double> ranks = calculateRanks(dependencies);
+        std::vector<int> inDegree = TKahnTopologicalSort::calculateInDegree(dependencies);
+
+        // Highest rank first, ties go to the node added first so the order is stable
+        const auto byRank = [&](const size_t a, const size_t b) {
+            return ranks[a] != ranks[b] ? ranks[a] < ranks[b] : a > b;
+        };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(byRank)> ready(byRank);
+
+        for (size_t id = 0; id < inDegree.size(); ++id)
+            if (inDegree[id] == 0)
+                ready.push(id);
+
+        std::vector<size_t> order;
+        order.reserve(nodes.size());
+
+        while (!ready.empty()) {
+            const size_t node = ready.top();
+            ready.pop();
+            order.push_back(node);
+
+            dependencies.forEachDependent(node, [&](const size_t dependency) {
+                if (--inDegree[dependency] == 0) {
+                    ready.push(dependency);
+                }
+            });
+        }
 
         if (order.size() != nodes.size())
             throw std::runtime_error("Cycle detected in dependency graph!");
 
         return order;
     }
-};
\ No newline at end of file
+
+    // Simulates a fixed amount of workers running the graph, each free worker takes whichever ready node comes first in the order
+    // Returns the estimated time until every node has finished
+    double estimateMakespan(const std::vector<size_t>& order, const TCompressedDependencies& dependencies, const size_t workerCount) const {
+        const size_t nodeCount = dependencies.getNodeCount();
+
+        std::vector<size_t> position(nodeCount);
+        for (size_t index = 0; index < order.size(); ++index)
+            position[order[index]] = index;
+
+        std::vector<int> inDegree = TKahnTopologicalSort::calculateInDegree(dependencies);
+
+        // Ready nodes by their place in the order, and running nodes by when they finish
+        const auto byPosition = [&](const size_t a, const size_t b) {
+            return position[a] > position[b];
+        };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(byPosition)> ready(byPosition);
+        std::priority_queue<std::pair<double, size_t>, std::vector<std::pair<double, size_t>>, std::greater<>> running;
+
+        for (size_t id = 0; id < nodeCount; ++id)
+            if (inDegree[id] == 0)
+                ready.push(id);
+
+        const size_t workers = workerCount > 0 ? workerCount : 1;
+        double time = 0.0;
+
+        while (!ready.empty() || !running.empty()) {
+            while (!ready.empty() && running.size() < workers) {
+                const size_t node = ready.top();
+                ready.pop();
+                running.emplace(time + getCost(node), node);
+            }
+
+            // Move on to when the next node finishes, freeing its worker
+            const auto [finish, node] = running.top();
+            running.pop();
+            time = finish;
+
+            dependencies.forEachDependent(node, [&](const size_t dependency) {
+                if (--inDegree[dependency] == 0) {
+                    ready.push(dependency);
+                }
+            });
+        }
+        return time;
+    }
+
+private:
+
+    TCostEstimator costEstimator;
+};
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "DependencyGraph.h"
+
+// Runs the nodes of a dependency graph on a pool of workers, a node is started as soon as everything it depends on has finished
+// Each worker owns a queue of ready nodes, and will steal from the other workers when its own queue runs dry
+// The workers are started once and wait between executions, so running a small graph every frame doesn't pay for starting threads
+struct TParallelExecutor {
+
+    struct NodeTiming {
+        size_t worker = 0;
+
+        // Both are relative to the start of the execution
+        std::chrono::nanoseconds start{0};
+        std::chrono::nanoseconds end{0};
+
+        std::chrono::nanoseconds getDuration() const { return end - start; }
+    };
+
+    struct Result {
+        // Indexed by node id
+        std::vector<NodeTiming> timings;
+
+        // The order the nodes finished in, this is always a valid execution order
+        std::vector<size_t> completionOrder;
+
+        // The longest chain of dependent nodes by measured time, from first to last
+        std::vector<size_t> criticalPath;
+        std::chrono::nanoseconds criticalPathDuration{0};
+
+        std::chrono::nanoseconds totalDuration{0};
+    };
+
+    // The calling thread is used as a worker, so a thread count of 1 will run everything serially
+    explicit TParallelExecutor(const size_t threadCount = std::thread::hardware_concurrency())
+    : threadCount(threadCount > 0 ? threadCount : 1) {
+        workers.reserve(this->threadCount - 1);
+        try {
+            for (size_t worker = 1; worker < this->threadCount; ++worker)
+                workers.emplace_back([this, worker] { park(worker); });
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    TParallelExecutor(const TParallelExecutor&) = delete;
+
+    TParallelExecutor& operator=(const TParallelExecutor&) = delete;
+
+    ~TParallelExecutor() {
+        stop();
+    }
+
+    size_t getThreadCount() const { return threadCount; }
+
+    // Calls func(id, node) for every node of the graph, executions from different threads take turns
+    template <typename TType, typename TTopologicalSorter, typename TFunc>
+    Result operator()(TDependencyGraph<TType, TTopologicalSorter>& graph, TFunc&& func) {
+        const TCompressedDependencies& dependencies = graph.buildDependencies();
+        const size_t nodeCount = graph.getNodeCount();
+
+        Result result;
+        result.timings.resize(nodeCount);
+        result.completionOrder.resize(nodeCount);
+
+        if (nodeCount == 0) return result;
+
+        const std::vector<int> initialInDegree = TKahnTopologicalSort::calculateInDegree(dependencies);
+
+        ExecutionState state(nodeCount, threadCount);
+        for (size_t id = 0; id < nodeCount; ++id)
+            state.inDegree[id].store(initialInDegree[id], std::memory_order_relaxed);
+
+        // Each node that nothing depends on is spread between the workers
+        size_t readyCount = 0;
+        for (size_t id = 0; id < nodeCount; ++id) {
+            if (initialInDegree[id] == 0) {
+                state.queues[readyCount % threadCount].tasks.push_back(id);
+                ++readyCount;
+            }
+        }
+
+        if (readyCount == 0)
+            throw std::runtime_error("Cycle detected in dependency graph!");
+
+        state.queued.store(readyCount);
+        state.pending.store(readyCount);
+        state.begin = std::chrono::steady_clock::now();
+
+        auto job = [&](const size_t worker) noexcept {
+            try {
+                work(state, worker, graph, dependencies, func, result);
+            } catch (...) {
+                fail(state);
+            }
+        };
+        dispatch(job);
+
+        result.totalDuration = std::chrono::steady_clock::now() - state.begin;
+
+        if (state.exception)
+            std::rethrow_exception(state.exception);
+
+        if (state.completed.load() != nodeCount)
+            throw std::runtime_error("Cycle detected in dependency graph!");
+
+        buildCriticalPath(result, dependencies);
+
+        return result;
+    }
+
+private:
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    struct ExecutionState {
+        ExecutionState(const size_t nodeCount, const size_t threadCount)
+        : inDegree(new std::atomic<int>[nodeCount]),
+          queues(new WorkQueue[threadCount]),
+          threadCount(threadCount) {}
+
+        std::unique_ptr<std::atomic<int>[]> inDegree;
+        std::unique_ptr<WorkQueue[]> queues;
+        size_t threadCount;
+
+        // Nodes sitting in a queue
+        std::atomic<size_t> queued{0};
+        // Nodes either sitting in a queue or currently running, if this reaches 0 nothing else can become ready
+        std::atomic<size_t> pending{0};
+        std::atomic<size_t> completed{0};
+        std::atomic<bool> finished{false};
+
+        std::mutex waitMutex;
+        std::condition_variable waitCondition;
+
+        std::mutex exceptionMutex;
+        std::exception_ptr exception;
+
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    static bool pop(ExecutionState& state, const size_t worker, size_t& outId) {
+        // Take the most recently readied node from our own queue, it is most likely to still be in cache
+        {
+            WorkQueue& queue = state.queues[worker];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                outId = queue.tasks.back();
+                queue.tasks.pop_back();
+                state.queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        // Otherwise steal the oldest node from another worker
+        for (size_t i = 1; i < state.threadCount; ++i) {
+            WorkQueue& queue = state.queues[(worker + i) % state.threadCount];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                outId = queue.tasks.front();
+                queue.tasks.pop_front();
+                state.queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Keeps the first exception, which is thrown again once every worker has stopped
+    static void fail(ExecutionState& state) noexcept {
+        {
+            std::lock_guard lock(state.exceptionMutex);
+            if (!state.exception)
+                state.exception = std::current_exception();
+        }
+        finish(state);
+    }
+
+    static void finish(ExecutionState& state) {
+        {
+            std::lock_guard lock(state.waitMutex);
+            state.finished.store(true);
+        }
+        state.waitCondition.notify_all();
+    }
+
+    template <typename TType, typename TTopologicalSorter, typename TFunc>
+    static void work(ExecutionState& state, const size_t worker, TDependencyGraph<TType, TTopologicalSorter>& graph, const TCompressedDependencies& dependencies, TFunc& func, Result& result) {
+        while (!state.finished.load()) {
+            size_t id;
+            if (!pop(state, worker, id)) {
+                std::unique_lock lock(state.waitMutex);
+                state.waitCondition.wait(lock, [&] { return state.finished.load() || state.queued.load() > 0; });
+                continue;
+            }
+
+            NodeTiming& timing = result.timings[id];
+            timing.worker = worker;
+            timing.start = std::chrono::steady_clock::now() - state.begin;
+
+            try {
+                func(id, graph.getNode(id));
+            } catch (...) {
+                fail(state);
+                return;
+            }
+
+            timing.end = std::chrono::steady_clock::now() - state.begin;
+            result.completionOrder[state.completed.fetch_add(1)] = id;
+
+            // For each node that is no longer a dependent, add to our own queue
+            size_t readied = 0;
+            dependencies.forEachDependent(id, [&](const size_t dependency) {
+                if (state.inDegree[dependency].fetch_sub(1) == 1) {
+                    // Counted before being pushed so a thief can never see the counters go below 0
+                    state.pending.fetch_add(1);
+                    state.queued.fetch_add(1);
+
+                    WorkQueue& queue = state.queues[worker];
+                    std::lock_guard lock(queue.mutex);
+                    queue.tasks.push_back(dependency);
+                    ++readied;
+                }
+            });
+
+            if (readied > 0) {
+                // Taking the lock ensures a worker about to wait will see the new nodes
+                { std::lock_guard lock(state.waitMutex); }
+                if (readied == 1) state.waitCondition.notify_one();
+                else state.waitCondition.notify_all();
+            }
+
+            // Either everything is done, or what remains is stuck in a cycle
+            if (state.pending.fetch_sub(1) == 1)
+                finish(state);
+        }
+    }
+
+    static void buildCriticalPath(Result& result, const TCompressedDependencies& dependencies) {
+        const size_t nodeCount = result.timings.size();
+
+        // Longest time to reach the end of each node, the completion order guarantees every dependency is visited first
+        std::vector<std::chrono::nanoseconds> distance(nodeCount, std::chrono::nanoseconds{0});
+        std::vector<size_t> parent(nodeCount, SIZE_MAX);
+
+        size_t last = SIZE_MAX;
+        for (const size_t id : result.completionOrder) {
+            distance[id] += result.timings[id].getDuration();
+
+            if (last == SIZE_MAX || distance[id] > distance[last])
+                last = id;
+
+            dependencies.forEachDependent(id, [&](const size_t dependency) {
+                if (parent[dependency] == SIZE_MAX || distance[id] > distance[dependency]) {
+                    distance[dependency] = distance[id];
+                    parent[dependency] = id;
+                }
+            });
+        }
+
+        result.criticalPathDuration = distance[last];
+        for (size_t id = last; id != SIZE_MAX; id = parent[id])
+            result.criticalPath.push_back(id);
+        std::reverse(result.criticalPath.begin(), result.criticalPath.end());
+    }
+
+    // Runs job(worker) on every worker, the calling thread being worker 0, and returns once they have all finished
+    template <typename TJob>
+    void dispatch(TJob& job) {
+        std::lock_guard runLock(runMutex);
+        {
+            std::lock_guard lock(poolMutex);
+            jobContext = &job;
+            jobInvoke = [](void* context, const size_t worker) { (*static_cast<TJob*>(context))(worker); };
+            runningWorkers = workers.size();
+            ++generation;
+        }
+        poolCondition.notify_all();
+
+        job(0);
+
+        std::unique_lock lock(poolMutex);
+        doneCondition.wait(lock, [&] { return runningWorkers == 0; });
+    }
+
+    // Waits for each execution, remembering the last one it ran so it never runs the same one twice
+    void park(const size_t worker) {
+        size_t seenGeneration = 0;
+        std::unique_lock lock(poolMutex);
+        while (true) {
+            poolCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+
+            void (*invoke)(void*, size_t) = jobInvoke;
+            void* context = jobContext;
+            lock.unlock();
+            invoke(context, worker);
+            lock.lock();
+
+            if (--runningWorkers == 0)
+                doneCondition.notify_one();
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard lock(poolMutex);
+            stopping = true;
+        }
+        poolCondition.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+        workers.clear();
+    }
+
+    size_t threadCount;
+
+    std::vector<std::thread> workers;
+
+    // Only one execution uses the workers at a time
+    std::mutex runMutex;
+
+    std::mutex poolMutex;
+    std::condition_variable poolCondition;
+    std::condition_variable doneCondition;
+    size_t generation = 0;
+    size_t runningWorkers = 0;
+    bool stopping = false;
+    void (*jobInvoke)(void*, size_t) = nullptr;
+    void* jobContext = nullptr;
+};
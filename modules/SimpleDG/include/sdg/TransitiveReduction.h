@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "CompressedDependencies.h"
+
+// Removes every edge that is already implied by a longer path, such as a -> c when a -> b -> c exists
+// The order the graph can run in is unchanged, but there are fewer edges for a sorter or executor to walk
+// Reachability is kept as one bitset per node, so it takes nodes * nodes / 8 bytes and is meant for dense graphs
+struct TTransitiveReduction {
+
+    // Graphs with more nodes are left as they are, as the bitsets would take too much memory (the default takes 32 MiB)
+    size_t maxNodeCount = 16384;
+
+    // Returns false if the graph was too large to reduce
+    bool operator()(TCompressedDependencies& dependencies) {
+        const size_t nodeCount = dependencies.getNodeCount();
+        if (nodeCount == 0 || nodeCount > maxNodeCount)
+            return false;
+
+        buildOrder(dependencies);
+
+        const size_t wordCount = (nodeCount + 63) / 64;
+        reachable.assign(nodeCount * wordCount, 0);
+        keep.assign(dependencies.getEdgeCount(), false);
+
+        // Visiting in reverse order means everything a node can reach has been filled in before the node itself
+        for (size_t index = nodeCount; index > 0; --index) {
+            const size_t node = order[index - 1];
+            uint64_t* nodeReachable = reachable.data() + node * wordCount;
+
+            // Nearest dependents first, any dependent reachable through a nearer one is implied
+            edges.clear();
+            for (size_t edge = dependencies.offsets[node]; edge < dependencies.offsets[node + 1]; ++edge)
+                edges.push_back(edge);
+            std::sort(edges.begin(), edges.end(), [&](const size_t a, const size_t b) {
+                return position[dependencies.edges[a]] < position[dependencies.edges[b]];
+            });
+
+            for (const size_t edge : edges) {
+                const size_t dependent = dependencies.edges[edge];
+                if (nodeReachable[dependent / 64] & (uint64_t(1) << (dependent % 64)))
+                    continue;
+
+                keep[edge] = true;
+                nodeReachable[dependent / 64] |= uint64_t(1) << (dependent % 64);
+
+                const uint64_t* dependentReachable = reachable.data() + dependent * wordCount;
+                for (size_t word = 0; word < wordCount; ++word)
+                    nodeReachable[word] |= dependentReachable[word];
+            }
+        }
+
+        // Compact the kept edges in place, each node keeps its dependents in their original order
+        size_t written = 0;
+        for (size_t node = 0; node < nodeCount; ++node) {
+            const size_t begin = dependencies.offsets[node];
+            const size_t end = dependencies.offsets[node + 1];
+            dependencies.offsets[node] = written;
+            for (size_t edge = begin; edge < end; ++edge)
+                if (keep[edge])
+                    dependencies.edges[written++] = dependencies.edges[edge];
+        }
+        dependencies.offsets[nodeCount] = written;
+        dependencies.edges.resize(written);
+
+        return true;
+    }
+
+private:
+
+    // Any topological order will do, this only decides which nodes are visited first
+    void buildOrder(const TCompressedDependencies& dependencies) {
+        const size_t nodeCount = dependencies.getNodeCount();
+
+        inDegree.assign(nodeCount, 0);
+        for (const size_t dependent : dependencies.edges)
+            ++inDegree[dependent];
+
+        order.clear();
+        for (size_t node = 0; node < nodeCount; ++node)
+            if (inDegree[node] == 0)
+                order.push_back(node);
+
+        for (size_t front = 0; front < order.size(); ++front) {
+            dependencies.forEachDependent(order[front], [&](const size_t dependent) {
+                if (--inDegree[dependent] == 0)
+                    order.push_back(dependent);
+            });
+        }
+
+        if (order.size() != nodeCount)
+            throw std::runtime_error("Cycle detected in dependency graph!");
+
+        position.resize(nodeCount);
+        for (size_t index = 0; index < nodeCount; ++index)
+            position[order[index]] = index;
+    }
+
+    // Reused between calls so reducing the same graph again does not allocate
+    std::vector<size_t> inDegree;
+    std::vector<size_t> order;
+    std::vector<size_t> position;
+    std::vector<size_t> edges;
+    std::vector<uint64_t> reachable;
+    std::vector<bool> keep;
+};
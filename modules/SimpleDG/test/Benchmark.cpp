@@ -0,0 +1,337 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "sdg/DependencyGraph.h"
+
+/*
+ * Measures building and sorting graphs of different shapes and sizes
+ * Usage: Benchmark [--format csv|json] [--max-nodes N] [--output file]
+ */
+
+using namespace std::chrono;
+
+// Every allocation is counted, so each phase can report how many it made
+static std::atomic<size_t> allocationCount{0};
+static std::atomic<size_t> allocationBytes{0};
+
+static void* countedAllocate(const size_t size) {
+    ++allocationCount;
+    allocationBytes += size;
+    if (void* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+// Over-aligned types skip the plain operator new, so they are counted here
+static void* countedAllocate(const size_t size, const std::align_val_t alignment) {
+    ++allocationCount;
+    allocationBytes += size;
+    const size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    void* memory = _aligned_malloc(size > 0 ? size : 1, align);
+#else
+    // The size has to be a multiple of the alignment
+    const size_t rounded = (size + align - 1) / align * align;
+    void* memory = std::aligned_alloc(align, rounded > 0 ? rounded : align);
+#endif
+    if (memory)
+        return memory;
+    throw std::bad_alloc();
+}
+
+static void alignedFree(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+void* operator new(const size_t size) { return countedAllocate(size); }
+void* operator new[](const size_t size) { return countedAllocate(size); }
+void* operator new(const size_t size, const std::align_val_t alignment) { return countedAllocate(size, alignment); }
+void* operator new[](const size_t size, const std::align_val_t alignment) { return countedAllocate(size, alignment); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { alignedFree(memory); }
+
+// The most memory the whole process has held so far, in bytes
+// It only ever grows, so a case only raises it if it needed more than every case before it
+static size_t getProcessPeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+struct SPhase {
+    double milliseconds = 0.0;
+    size_t allocations = 0;
+    size_t bytes = 0;
+};
+
+// Times a function, along with the allocations it made
+template <typename TFunc>
+SPhase measure(TFunc&& func) {
+    const size_t startCount = allocationCount.load();
+    const size_t startBytes = allocationBytes.load();
+    const auto start = steady_clock::now();
+
+    func();
+
+    SPhase phase;
+    phase.milliseconds = duration<double, std::milli>(steady_clock::now() - start).count();
+    phase.allocations = allocationCount.load() - startCount;
+    phase.bytes = allocationBytes.load() - startBytes;
+    return phase;
+}
+
+struct SResult {
+    std::string shape;
+    size_t nodes = 0;
+    size_t edges = 0;
+
+    SPhase addNodes;
+    SPhase addEdges;
+    SPhase buildOrder;
+    // Building again without changes, which the graphs cache
+    SPhase rebuildOrder;
+
+    // The high water mark of the process after the case, not the memory of the case itself, see the allocated bytes of each phase for that
+    size_t processPeakResidentBytes = 0;
+};
+
+// Edges only go from lower to higher ids, so the graph can never have a cycle
+void addRandomEdges(TSimpleDependencyGraph<size_t, TKahnTopologicalSort>& graph, const size_t nodeCount, std::mt19937_64& random) {
+    for (size_t node = 1; node < nodeCount; ++node) {
+        for (size_t edge = 0; edge < 4; ++edge) {
+            graph.addDependency(random() % node, node);
+        }
+    }
+}
+
+void addChainEdges(TSimpleDependencyGraph<size_t, TKahnTopologicalSort>& graph, const size_t nodeCount, std::mt19937_64&) {
+    for (size_t node = 1; node < nodeCount; ++node) {
+        graph.addDependency(node - 1, node);
+    }
+}
+
+// One root that everything depends on, and one sink that depends on everything
+void addFanOutEdges(TSimpleDependencyGraph<size_t, TKahnTopologicalSort>& graph, const size_t nodeCount, std::mt19937_64&) {
+    for (size_t node = 1; node + 1 < nodeCount; ++node) {
+        graph.addDependency(0, node);
+        graph.addDependency(node, nodeCount - 1);
+    }
+}
+
+template <typename TFunc>
+SResult runSimple(const std::string& shape, const size_t nodeCount, TFunc&& addEdges) {
+    std::mt19937_64 random(nodeCount);
+
+    SResult result;
+    result.shape = shape;
+    result.nodes = nodeCount;
+
+    TSimpleDependencyGraph<size_t, TKahnTopologicalSort> graph;
+
+    result.addNodes = measure([&] {
+        for (size_t node = 0; node < nodeCount; ++node) {
+            graph.addNode(node);
+        }
+    });
+
+    result.addEdges = measure([&] { addEdges(graph, nodeCount, random); });
+
+    size_t orderSize = 0;
+    result.buildOrder = measure([&] { orderSize = graph.buildExecutionOrder().size(); });
+    result.rebuildOrder = measure([&] { orderSize = graph.buildExecutionOrder().size(); });
+
+    result.edges = graph.buildDependencies().getEdgeCount();
+    result.processPeakResidentBytes = getProcessPeakResidentBytes();
+
+    if (orderSize != nodeCount)
+        throw std::runtime_error("Order is missing nodes!");
+
+    return result;
+}
+
+// Each node reads two resources and writes one, with a resource for every 10 nodes
+SResult runReadWrite(const size_t nodeCount) {
+    std::mt19937_64 random(nodeCount);
+    const size_t resourceCount = nodeCount / 10 + 1;
+
+    SResult result;
+    result.shape = "rw";
+    result.nodes = nodeCount;
+
+    TRWDependencyGraph<size_t, size_t, TKahnTopologicalSort> graph;
+
+    result.addNodes = measure([&] {
+        for (size_t node = 0; node < nodeCount; ++node) {
+            graph.addNode(node);
+        }
+    });
+
+    result.addEdges = measure([&] {
+        for (size_t node = 0; node < nodeCount; ++node) {
+            graph.addRead(node, random() % resourceCount);
+            graph.addRead(node, random() % resourceCount);
+            graph.addWrite(node, random() % resourceCount);
+        }
+    });
+
+    size_t orderSize = 0;
+    result.buildOrder = measure([&] { orderSize = graph.buildExecutionOrder().size(); });
+    result.rebuildOrder = measure([&] { orderSize = graph.buildExecutionOrder().size(); });
+
+    result.edges = graph.buildDependencies().getEdgeCount();
+    result.processPeakResidentBytes = getProcessPeakResidentBytes();
+
+    if (orderSize != nodeCount)
+        throw std::runtime_error("Order is missing nodes!");
+
+    return result;
+}
+
+// Simulates random graphs with random costs on a fixed amount of workers, in Kahn's order and in the critical path order
+void compareMakespan(const size_t graphCount, const size_t nodeCount, const size_t workerCount) {
+    std::mt19937_64 random(graphCount);
+
+    double kahnMakespan = 0.0;
+    double criticalPathMakespan = 0.0;
+    size_t shorter = 0;
+    size_t longer = 0;
+
+    const std::vector<size_t> nodes(nodeCount);
+    std::vector<double> costs(nodeCount);
+
+    for (size_t graph = 0; graph < graphCount; ++graph) {
+        // Edges only go from lower to higher ids, so the graph can never have a cycle
+        std::vector<std::pair<size_t, size_t>> edges;
+        for (size_t edge = 0; edge < nodeCount * 3; ++edge) {
+            size_t from = random() % nodeCount;
+            size_t to = random() % nodeCount;
+            if (from == to) continue;
+            if (from > to) std::swap(from, to);
+            edges.emplace_back(from, to);
+        }
+        const TCompressedDependencies dependencies(nodeCount, edges);
+
+        for (double& cost : costs)
+            cost = static_cast<double>(1 + random() % 20);
+
+        TCriticalPathSort sorter;
+        sorter.setCostEstimator([&](const size_t node) { return costs[node]; });
+
+        const double kahn = sorter.estimateMakespan(TKahnTopologicalSort()(nodes, dependencies), dependencies, workerCount);
+        const double criticalPath = sorter.estimateMakespan(sorter(nodes, dependencies), dependencies, workerCount);
+
+        kahnMakespan += kahn;
+        criticalPathMakespan += criticalPath;
+        shorter += criticalPath < kahn;
+        longer += criticalPath > kahn;
+    }
+
+    std::cerr << "Makespan of " << graphCount << " random " << nodeCount << " node graphs on " << workerCount << " workers, Kahn: " << kahnMakespan
+              << ", Critical path: " << criticalPathMakespan << " (shorter on " << shorter << ", longer on " << longer << ")" << std::endl;
+}
+
+void writeCSV(std::ostream& stream, const std::vector<SResult>& results) {
+    stream << "shape,nodes,edges";
+    for (const char* phase : {"addNodes", "addEdges", "buildOrder", "rebuildOrder"})
+        stream << "," << phase << "Ms," << phase << "Allocations," << phase << "Bytes";
+    stream << ",processPeakResidentBytes\n";
+
+    for (const auto& result : results) {
+        stream << result.shape << "," << result.nodes << "," << result.edges;
+        for (const SPhase* phase : {&result.addNodes, &result.addEdges, &result.buildOrder, &result.rebuildOrder})
+            stream << "," << phase->milliseconds << "," << phase->allocations << "," << phase->bytes;
+        stream << "," << result.processPeakResidentBytes << "\n";
+    }
+}
+
+void writeJSON(std::ostream& stream, const std::vector<SResult>& results) {
+    const auto writePhase = [&](const char* name, const SPhase& phase) {
+        stream << "\"" << name << "\": {\"ms\": " << phase.milliseconds << ", \"allocations\": " << phase.allocations << ", \"bytes\": " << phase.bytes << "}, ";
+    };
+
+    stream << "[\n";
+    for (size_t index = 0; index < results.size(); ++index) {
+        const SResult& result = results[index];
+        stream << "  {\"shape\": \"" << result.shape << "\", \"nodes\": " << result.nodes << ", \"edges\": " << result.edges << ", ";
+        writePhase("addNodes", result.addNodes);
+        writePhase("addEdges", result.addEdges);
+        writePhase("buildOrder", result.buildOrder);
+        writePhase("rebuildOrder", result.rebuildOrder);
+        stream << "\"processPeakResidentBytes\": " << result.processPeakResidentBytes << "}" << (index + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "]\n";
+}
+
+int main(const int argc, char** argv) {
+
+    std::string format = "csv";
+    std::string output;
+    size_t maxNodes = 1000000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string argument = argv[i];
+        if (argument == "--format") format = argv[i + 1];
+        else if (argument == "--output") output = argv[i + 1];
+        else if (argument == "--max-nodes") maxNodes = std::stoull(argv[i + 1]);
+    }
+
+    std::vector<SResult> results;
+
+    for (size_t nodeCount = 100; nodeCount <= maxNodes; nodeCount *= 10) {
+        results.push_back(runSimple("random", nodeCount, addRandomEdges));
+        results.push_back(runSimple("chain", nodeCount, addChainEdges));
+        results.push_back(runSimple("fanout", nodeCount, addFanOutEdges));
+        results.push_back(runReadWrite(nodeCount));
+
+        std::cerr << "Finished " << nodeCount << " nodes" << std::endl;
+    }
+
+    compareMakespan(200, 200, 8);
+
+    std::ofstream file;
+    if (!output.empty())
+        file.open(output);
+    std::ostream& stream = output.empty() ? std::cout : file;
+
+    if (format == "json") writeJSON(stream, results);
+    else writeCSV(stream, results);
+
+    return 0;
+}
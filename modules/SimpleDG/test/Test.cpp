@@ -5,6 +5,7 @@
 #include <functional>
 
 #include "sdg/DependencyGraph.h"
+#include "sdg/ParallelExecutor.h"
 
 using namespace std::chrono;
 
@@ -90,6 +91,32 @@ int main() {
 #endif
         std::cout << std::endl << std::endl;
 
+        // Run the passes on a worker pool, timing each one
+        TParallelExecutor executor;
+        const auto result = executor(graph, [](size_t, const std::shared_ptr<SObject>& pass) {
+            pass->print();
+        });
+
+        std::cout << std::endl << "Critical path (" << duration_cast<microseconds>(result.criticalPathDuration).count() << "us of " << duration_cast<microseconds>(result.totalDuration).count() << "us): ";
+        for (const auto& node : result.criticalPath) {
+            std::cout << graph.getNode(node)->name << " -> ";
+        }
+        std::cout << std::endl << std::endl;
+
+        // The executor derived its edges from the same accesses as the order, so it reused the plan
+        std::cout << "Plan cache: " << graph.getPlanCacheHits() << " hits, " << graph.getPlanCacheMisses() << " misses" << std::endl << std::endl;
+
+        // Each pass reads and writes HDR, so most of the derived edges are implied by the chain between them
+        graph.setTransitiveReduction(true);
+        const auto& plan = graph.buildExecutionPlan();
+        std::cout << "Transitive reduction: " << plan.derivedEdgeCount << " -> " << plan.dependencies.getEdgeCount() << " edges" << std::endl << std::endl;
+
+        // A miss only evicts the least recently used plan once the cache is full, so the reduced plan is still valid
+        graph.setPlanCacheCapacity(2);
+        graph.addRead(upscalePass, depth);
+        const auto& depthPlan = graph.buildExecutionPlan();
+        std::cout << "Kept plans: " << plan.dependencies.getEdgeCount() << " and " << depthPlan.dependencies.getEdgeCount() << " edges" << std::endl << std::endl;
+
         /*
         Resource lifetime tracking,
         aliasing,
@@ -102,5 +129,202 @@ int main() {
          */
     }
 
+    {
+        // Shadows and the depth prepass have no dependencies on each other, so they share a wave
+        TSimpleDependencyGraph<std::shared_ptr<SObject>, TKahnWavefrontSort> graph;
+
+        size_t shadowPass = graph.addNode(std::make_shared<SObject>("shadowPass"));
+        size_t depthPrepass = graph.addNode(std::make_shared<SObject>("depthPrepass"));
+        size_t gbufferPass = graph.addNode(std::make_shared<SObject>("gbufferPass"));
+        size_t lightingPass = graph.addNode(std::make_shared<SObject>("lightingPass"));
+        size_t ssaoPass = graph.addNode(std::make_shared<SObject>("ssaoPass"));
+
+        graph.addDependency(depthPrepass, gbufferPass);
+        graph.addDependency(depthPrepass, ssaoPass);
+        graph.addDependency(gbufferPass, lightingPass);
+        graph.addDependency(shadowPass, lightingPass);
+        graph.addDependency(ssaoPass, lightingPass);
+
+        const auto waves = graph.buildExecutionOrder();
+
+#ifdef USING_SIMPLESTL
+        waves.forEach([&](size_t index, const TVector<size_t>& wave) {
+            std::cout << "Wave " << index << ": ";
+            wave.forEach([&](size_t, const size_t& node) {
+                std::cout << graph.getNode(node)->name << " ";
+            });
+            std::cout << std::endl;
+        });
+#else
+        for (size_t index = 0; index < waves.size(); ++index) {
+            std::cout << "Wave " << index << ": ";
+            for (const auto& node : waves[index]) {
+                std::cout << graph.getNode(node)->name << " ";
+            }
+            std::cout << std::endl;
+        }
+#endif
+        std::cout << std::endl;
+    }
+
+    {
+        // The order is kept between frames, so only the passes around a changed dependency are moved
+        TSimpleDependencyGraph<std::shared_ptr<SObject>, TIncrementalTopologicalSort> graph;
+
+        size_t lightingPass = graph.addNode(std::make_shared<SObject>("lightingPass"));
+        size_t gbufferPass = graph.addNode(std::make_shared<SObject>("gbufferPass"));
+        size_t depthPrepass = graph.addNode(std::make_shared<SObject>("depthPrepass"));
+        size_t postProcessPass = graph.addNode(std::make_shared<SObject>("postProcessPass"));
+
+        graph.addDependency(gbufferPass, lightingPass);
+        graph.addDependency(depthPrepass, gbufferPass);
+        graph.addDependency(lightingPass, postProcessPass);
+
+        const auto printOrder = [&] {
+            const auto order = graph.buildExecutionOrder();
+#ifdef USING_SIMPLESTL
+            order.forEach([&](size_t, const size_t& node) {
+                std::cout << graph.getNode(node)->name << " -> ";
+            });
+#else
+            for (const auto& node : order) {
+                std::cout << graph.getNode(node)->name << " -> ";
+            }
+#endif
+            std::cout << std::endl;
+        };
+
+        printOrder();
+
+        // Post processing feeding back into the depth prepass would be a cycle, so it is rejected
+        try {
+            graph.addDependency(postProcessPass, depthPrepass);
+        } catch (const std::runtime_error& error) {
+            std::cout << error.what() << std::endl;
+        }
+
+        // A pass that was never added can't be depended on either
+        try {
+            graph.addDependency(postProcessPass, postProcessPass + 1);
+        } catch (const std::runtime_error& error) {
+            std::cout << error.what() << std::endl;
+        }
+
+        // The next frame skips lighting, so post processing only needs the gbuffer
+        graph.removeDependency(lightingPass, postProcessPass);
+        graph.removeDependency(gbufferPass, lightingPass);
+        graph.addDependency(postProcessPass, lightingPass);
+        graph.addDependency(gbufferPass, postProcessPass);
+
+        printOrder();
+        std::cout << std::endl;
+    }
+
+    {
+        // The gbuffer is finished with once lighting has read it, so the bloom and tonemapping targets can reuse its memory
+        TRWDependencyGraph<std::shared_ptr<SObject>, std::shared_ptr<SResource>, TKahnTopologicalSort> graph;
+
+        const auto albedo = std::make_shared<SResource>(0);
+        const auto normal = std::make_shared<SResource>(1);
+        const auto depth = std::make_shared<SResource>(2);
+        const auto hdrColor = std::make_shared<SResource>(3);
+        const auto bloom = std::make_shared<SResource>(4);
+        const auto ldrColor = std::make_shared<SResource>(5);
+
+        size_t gbufferPass = graph.addNode(std::make_shared<SObject>("gbufferPass"));
+        graph.addWrite(gbufferPass, albedo);
+        graph.addWrite(gbufferPass, normal);
+        graph.addWrite(gbufferPass, depth);
+
+        size_t lightingPass = graph.addNode(std::make_shared<SObject>("lightingPass"));
+        graph.addRead(lightingPass, albedo);
+        graph.addRead(lightingPass, normal);
+        graph.addRead(lightingPass, depth);
+        graph.addWrite(lightingPass, hdrColor);
+
+        size_t bloomPass = graph.addNode(std::make_shared<SObject>("bloomPass"));
+        graph.addRead(bloomPass, hdrColor);
+        graph.addWrite(bloomPass, bloom);
+
+        size_t tonemapPass = graph.addNode(std::make_shared<SObject>("tonemapPass"));
+        graph.addRead(tonemapPass, hdrColor);
+        graph.addRead(tonemapPass, bloom);
+        graph.addWrite(tonemapPass, ldrColor);
+
+        // Sizes of 1080p targets
+        std::vector<size_t> sizes(graph.getResourceCount());
+        sizes[graph.getResourceIndex(albedo)] = 1920 * 1080 * 4;
+        sizes[graph.getResourceIndex(normal)] = 1920 * 1080 * 8;
+        sizes[graph.getResourceIndex(depth)] = 1920 * 1080 * 4;
+        sizes[graph.getResourceIndex(hdrColor)] = 1920 * 1080 * 8;
+        sizes[graph.getResourceIndex(bloom)] = 960 * 540 * 8;
+        sizes[graph.getResourceIndex(ldrColor)] = 1920 * 1080 * 4;
+
+        const auto plan = graph.buildAliasingPlan(sizes);
+
+        std::cout << "Aliasing: " << plan.slotSizes.size() << " slots, " << plan.unaliasedBytes / 1024 << "KiB -> " << plan.aliasedBytes / 1024
+                  << "KiB (peak live " << plan.peakLiveBytes / 1024 << "KiB)" << std::endl << std::endl;
+
+        // Accesses can only be added to passes that exist, and ones left past the last pass are caught when building
+        try {
+            graph.addWrite(tonemapPass + 1, ldrColor);
+        } catch (const std::runtime_error& error) {
+            std::cout << error.what() << std::endl;
+        }
+
+        graph.dependencies.emplace_back();
+        try {
+            graph.buildExecutionPlan();
+        } catch (const std::runtime_error& error) {
+            std::cout << error.what() << std::endl;
+        }
+        graph.dependencies.pop_back();
+        std::cout << std::endl;
+    }
+
+    {
+        // Shadows are a long chain, so starting them first lets the cheap passes fill in around them
+        struct SPass {
+            std::string name;
+            double cost;
+        };
+
+        const std::vector<SPass> passes = {
+            {"uiPass", 2.0}, {"particlesPass", 2.0}, {"decalsPass", 2.0}, {"reflectionProbePass", 2.0},
+            {"shadowPass", 1.0}, {"shadowFilterPass", 4.0}, {"lightingPass", 4.0}
+        };
+
+        TSimpleDependencyGraph<SPass, TCriticalPathSort> graph;
+        for (const auto& pass : passes) {
+            graph.addNode(pass);
+        }
+
+        graph.addDependency(4, 5);
+        graph.addDependency(5, 6);
+
+        graph.setCostEstimator([&](const size_t node) {
+            return graph.getNode(node).cost;
+        });
+
+        const TCompressedDependencies& dependencies = graph.buildDependencies();
+        const std::vector<size_t> kahnOrder = TKahnTopologicalSort()(passes, dependencies);
+        const std::vector<size_t> criticalPathOrder = graph.getSorter()(passes, dependencies);
+
+        for (const auto& node : criticalPathOrder) {
+            std::cout << graph.getNode(node).name << " -> ";
+        }
+        std::cout << std::endl;
+
+        std::cout << "Makespan on 2 workers, Kahn: " << graph.getSorter().estimateMakespan(kahnOrder, dependencies, 2)
+                  << ", Critical path: " << graph.getSorter().estimateMakespan(criticalPathOrder, dependencies, 2) << std::endl << std::endl;
+
+        // The graph keeps the order it built until the costs change, so a slower uiPass then starts first
+        std::cout << graph.getNode(graph.buildExecutionOrder()[0]).name << " starts first";
+        graph.setCostEstimator([&](const size_t node) {
+            return node == 0 ? 20.0 : graph.getNode(node).cost;
+        });
+        std::cout << ", then " << graph.getNode(graph.buildExecutionOrder()[0]).name << " with a slower uiPass" << std::endl << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <cassert>
 #include <memory>
+#include <new>
+#include <thread>
+#include <utility>
 
 namespace sstl {
 	template <typename>
@@ -58,10 +63,8 @@ namespace sstl {
 		struct is_destroyable : std::false_type {};
 
 		template <typename TType>
-		struct is_destroyable<
-			std::void_t<decltype(std::declval<TType&>().destroy())>,
-			TType
-		> : std::true_type {};
+		struct is_destroyable<TType, std::void_t<decltype(std::declval<TType&>().destroy())>>
+			: std::true_type {};
 
 		template <typename TType>
 		constexpr bool is_destroyable_v = is_destroyable<TType>::value;
@@ -98,6 +101,30 @@ namespace sstl {
 	#endif
 #endif
 
+	// Types that count their own references, which TIntrusive adds to and releases
+	// Named apart from release, so a reference counted type isn't also treated as releasable
+	#if CXX_VERSION >= 20
+		template <typename TType>
+		concept is_ref_counted_v =
+		requires(TType& obj) {
+			obj.addRef();
+			obj.releaseRef();
+		};
+
+		template <typename TType>
+		struct is_ref_counted : std::bool_constant<is_ref_counted_v<TType>> {};
+	#else
+		template <typename, typename = void>
+		struct is_ref_counted : std::false_type {};
+
+		template <typename TType>
+		struct is_ref_counted<TType, std::void_t<decltype(std::declval<TType&>().addRef()), decltype(std::declval<TType&>().releaseRef())>>
+			: std::true_type {};
+
+		template <typename TType>
+		constexpr bool is_ref_counted_v = is_ref_counted<TType>::value;
+	#endif
+
 	template <typename TType>
 	struct deleter {
 		constexpr deleter() noexcept = default;
@@ -148,6 +175,55 @@ namespace sstl {
 		}
 	};
 
+	// Used with std::allocate_shared, so the object is created in the same allocation as its control block
+	// The control block destroys the object through the allocator, which is where destroy is called
+	template <typename TType>
+	struct shared_allocator {
+		using value_type = TType;
+
+		template <typename TOtherType>
+		struct rebind {
+			using other = shared_allocator<TOtherType>;
+		};
+
+		constexpr shared_allocator() noexcept = default;
+
+		template <typename TOtherType>
+		constexpr shared_allocator(const shared_allocator<TOtherType>&) noexcept {}
+
+		TType* allocate(const size_t count) {
+			return std::allocator<TType>().allocate(count);
+		}
+
+		void deallocate(TType* ptr, const size_t count) noexcept {
+			std::allocator<TType>().deallocate(ptr, count);
+		}
+
+		template <typename TOtherType>
+		void destroy(TOtherType* ptr) noexcept {
+			if constexpr (sstl::is_destroyable_v<TOtherType>) {
+				ptr->destroy();
+			}
+			ptr->~TOtherType();
+		}
+
+		template <typename TOtherType>
+		friend constexpr bool operator==(const shared_allocator&, const shared_allocator<TOtherType>&) noexcept { return true; }
+
+		template <typename TOtherType>
+		friend constexpr bool operator!=(const shared_allocator&, const shared_allocator<TOtherType>&) noexcept { return false; }
+	};
+
+	// Releasable types free themselves, which they can't do when they live inside a control block, so they are still allocated on their own
+	template <typename TType, typename... TArgs>
+	std::shared_ptr<TType> make_shared(TArgs&&... args) {
+		if constexpr (sstl::is_releasable_v<TType>) {
+			return std::shared_ptr<TType>(new TType(std::forward<TArgs>(args)...), sstl::deleter<TType>());
+		} else {
+			return std::allocate_shared<TType>(shared_allocator<TType>(), std::forward<TArgs>(args)...);
+		}
+	}
+
 	template <typename TType>
 	struct SharedDeleter {
 		using Type = TType;
@@ -380,7 +456,7 @@ struct TShared {
 	_CONSTEXPR23 TShared() noexcept {
 		// If not default constructible, default to nullptr
 		if constexpr (std::is_default_constructible_v<TType>) {
-			m_ptr = std::shared_ptr<TType>(new TType(), sstl::deleter<TType>());
+			m_ptr = sstl::make_shared<TType>();
 			if constexpr (sstl::is_initializable_v<TType>) {
 				m_ptr->init();
 			}
@@ -415,7 +491,7 @@ struct TShared {
 			int> = 0
 	>
 	_CONSTEXPR23 explicit TShared(TArgs&&... args) noexcept {
-		m_ptr = std::shared_ptr<TType>(new TType(std::forward<TArgs>(args)...), sstl::deleter<TType>());
+		m_ptr = sstl::make_shared<TType>(std::forward<TArgs>(args)...);
 		if constexpr (sstl::is_initializable_v<TType>) {
 			m_ptr->init();
 		}
@@ -1076,69 +1152,898 @@ private:
 	mutable std::weak_ptr<TType> _Wptr;
 };
 
-template <typename TType>
-struct TUnfurled {
-	using Type = TType;
-	constexpr static bool isManaged = false;
+namespace sstl {
 
-	template <typename TOtherType = TType, typename... TArgs,
-		std::enable_if_t<std::is_convertible_v<TOtherType, TType>, int> = 0
-	>
-	constexpr static TType create(TArgs&&... args)
-#if CXX_VERSION >= 20
-noexcept(std::is_nothrow_convertible_v<TOtherType, TType>) {
-#else
-noexcept {
+	// The counts behind TLocalShared and TLocalWeak, plain integers as nothing but the thread that made them may touch them
+	// The object goes when the last TLocalShared does, and the counts when the last TLocalWeak does after that
+	struct SLocalCounts {
+		size_t strong = 1;
+		size_t weak = 0;
+
+#ifndef NDEBUG
+		std::thread::id owner = std::this_thread::get_id();
+#endif
+
+		virtual ~SLocalCounts() = default;
+
+		// Destroys the object, leaving the counts for any TLocalWeak still looking at them
+		virtual void dispose() noexcept = 0;
+
+		void checkThread() const noexcept {
+#ifndef NDEBUG
+			assert(owner == std::this_thread::get_id() && "A TLocalShared or TLocalWeak was used on a thread other than the one that created it!");
 #endif
-		TOtherType obj{std::forward<TArgs>(args)...};
-		if constexpr (sstl::is_initializable_v<TOtherType>) {
-			obj.init();
 		}
-		return obj;
-	}
-};
 
+		void addStrong() noexcept {
+			checkThread();
+			++strong;
+		}
+
+		void releaseStrong() noexcept {
+			checkThread();
+			if (--strong == 0) {
+				// Held across dispose, as the object may own the last TLocalWeak through TLocalSharedFrom
+				++weak;
+				dispose();
+				if (--weak == 0) delete this;
+			}
+		}
+
+		void addWeak() noexcept {
+			checkThread();
+			++weak;
+		}
+
+		void releaseWeak() noexcept {
+			checkThread();
+			if (--weak == 0 && strong == 0) delete this;
+		}
+	};
+
+	// Holds the object itself, so it takes a single allocation
+	template <typename TType>
+	struct TLocalInplaceCounts final : SLocalCounts {
+
+		template <typename... TArgs>
+		explicit TLocalInplaceCounts(TArgs&&... args) {
+			::new (static_cast<void*>(m_Storage)) TType(std::forward<TArgs>(args)...);
+		}
+
+		TType* get() noexcept { return std::launder(reinterpret_cast<TType*>(m_Storage)); }
+
+		virtual void dispose() noexcept override {
+			if constexpr (sstl::is_destroyable_v<TType>) {
+				get()->destroy();
+			}
+			std::destroy_at(get());
+		}
+
+	private:
+		alignas(TType) unsigned char m_Storage[sizeof(TType)];
+	};
+
+	// Takes ownership of an object allocated elsewhere, freeing it with sstl::deleter
+	template <typename TType>
+	struct TLocalPointerCounts final : SLocalCounts {
+
+		explicit TLocalPointerCounts(TType* ptr) noexcept: m_ptr(ptr) {}
+
+		virtual void dispose() noexcept override {
+			sstl::deleter<TType>()(m_ptr);
+		}
+
+	private:
+		TType* m_ptr;
+	};
+}
+
+template <typename>
+struct TLocalWeak;
+
+template <typename>
+struct TLocalSharedFrom;
+
+// TShared for objects that never leave the thread that created them, counting references with plain integers rather than atomics
+// Debug builds assert that every copy, reset and lock happens on the creating thread
 template <typename TType>
-struct TUnfurled<TShared<TType>> {
-	using Type = TType;
-	constexpr static bool isManaged = true;
-	constexpr static auto get = &TShared<TType>::get;
+struct TLocalShared {
 
-	template <typename TOtherType = TType, typename... TArgs,
+	TLocalShared() noexcept {
+		// If not default constructible, default to nullptr
+		if constexpr (std::is_default_constructible_v<TType>) {
+			create();
+		}
+	}
+
+	TLocalShared(nullptr_t) noexcept {}
+
+	TLocalShared& operator=(nullptr_t) noexcept {
+		reset();
+		return *this;
+	}
+
+	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
-	_CONSTEXPR23 static TShared<TType> create(TArgs&&... args)
-#if CXX_VERSION >= 20
-	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
-#else
-	noexcept {
-#endif
-		return TShared<TOtherType>(std::forward<TArgs>(args)...);
+	explicit TLocalShared(TOtherType* ptr) noexcept {
+		if (ptr) {
+			m_ptr = ptr;
+			m_Counts = new sstl::TLocalPointerCounts<TOtherType>(ptr);
+			enableSharedFrom(ptr);
+		}
 	}
-};
 
-template <typename TType>
-struct TUnfurled<TUnique<TType>> {
-	using Type = TType;
-	constexpr static bool isManaged = true;
-	constexpr static auto get = &TUnique<TType>::get;
+	template <typename... TArgs,
+		std::enable_if_t<
+			std::conjunction_v<
+				std::negation<std::is_null_pointer<std::decay_t<TArgs>>>...,
+				std::negation<sstl::is_managed<std::decay_t<TArgs>>>...
+			>,
+			int> = 0
+	>
+	explicit TLocalShared(TArgs&&... args) noexcept {
+		create(std::forward<TArgs>(args)...);
+	}
 
-	template <typename TOtherType = TType, typename... TArgs,
-		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	template <typename TOtherType>
+	TLocalShared(const TLocalWeak<TOtherType>& weak) noexcept;
+
+	template <typename TOtherType>
+	TLocalShared(TLocalWeak<TOtherType>& weak) noexcept
+	: TLocalShared(std::as_const(weak)) {}
+
+	TLocalShared(const TLocalShared& otr) noexcept
+	: m_ptr(otr.m_ptr), m_Counts(otr.m_Counts) {
+		if (m_Counts) m_Counts->addStrong();
+	}
+
+	// Non-const lvalues would otherwise be taken by the variadic constructor, and copied into a new object
+	TLocalShared(TLocalShared& otr) noexcept
+	: TLocalShared(std::as_const(otr)) {}
+
+	TLocalShared(TLocalShared&& otr) noexcept
+	: m_ptr(std::exchange(otr.m_ptr, nullptr)), m_Counts(std::exchange(otr.m_Counts, nullptr)) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_same<TOtherType, TType>>, std::is_convertible<TOtherType*, TType*>>, int> = 0
 	>
-	_CONSTEXPR23 static TUnique<TType> create(TArgs&&... args)
-#if CXX_VERSION >= 20
-	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
-#else
-	noexcept {
-#endif
-		return TUnique<TOtherType>(std::forward<TArgs>(args)...);
+	TLocalShared(TLocalShared<TOtherType>&& otr) noexcept
+	: m_ptr(std::exchange(otr.m_ptr, nullptr)), m_Counts(std::exchange(otr.m_Counts, nullptr)) {}
+
+	~TLocalShared() {
+		reset();
+	}
+
+	TLocalShared& operator=(const TLocalShared& otr) noexcept {
+		TLocalShared(otr).swap(*this);
+		return *this;
+	}
+
+	TLocalShared& operator=(TLocalShared&& otr) noexcept {
+		TLocalShared(std::move(otr)).swap(*this);
+		return *this;
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_same<TOtherType, TType>>, std::is_convertible<TOtherType*, TType*>>, int> = 0
+	>
+	TLocalShared& operator=(TLocalShared<TOtherType>&& otr) noexcept {
+		TLocalShared(std::move(otr)).swap(*this);
+		return *this;
+	}
+
+	size_t count() const noexcept {
+		return m_Counts ? m_Counts->strong : 0;
+	}
+
+	// Releases ownership of the pointer, note the object will not be destroyed unless all other shared pointers are
+	void destroy() noexcept {
+		reset();
+	}
+
+	template <typename TOtherType>
+	TLocalShared<TOtherType> staticCast() const noexcept {
+		return TLocalShared<TOtherType>(m_Counts, static_cast<TOtherType*>(m_ptr));
+	}
+
+	// Empty if the cast fails, as with std::dynamic_pointer_cast
+	template <typename TOtherType>
+	TLocalShared<TOtherType> dynamicCast() const noexcept {
+		if (auto ptr = dynamic_cast<TOtherType*>(m_ptr)) {
+			return TLocalShared<TOtherType>(m_Counts, ptr);
+		}
+		return nullptr;
+	}
+
+	template <typename TOtherType>
+	TLocalShared<TOtherType> reinterpretCast() const noexcept {
+		return TLocalShared<TOtherType>(m_Counts, reinterpret_cast<TOtherType*>(m_ptr));
+	}
+
+	template <typename TOtherType>
+	TLocalShared<TOtherType> constCast() const noexcept {
+		return TLocalShared<TOtherType>(m_Counts, const_cast<TOtherType*>(m_ptr));
+	}
+
+	TType* operator->() const noexcept {
+		return m_ptr;
+	}
+
+	TType& operator*() const noexcept {
+		return *m_ptr;
+	}
+
+	TType* get() const noexcept { return m_ptr; }
+
+	operator bool() const noexcept {
+		return m_ptr != nullptr;
+	}
+
+	friend bool operator<(const TLocalShared& fst, const TLocalShared& snd) noexcept {
+		return fst.m_ptr < snd.m_ptr;
+	}
+
+	friend bool operator<=(const TLocalShared& fst, const TLocalShared& snd) noexcept {
+		return fst.m_ptr <= snd.m_ptr;
+	}
+
+	friend bool operator>(const TLocalShared& fst, const TLocalShared& snd) noexcept {
+		return fst.m_ptr > snd.m_ptr;
+	}
+
+	friend bool operator>=(const TLocalShared& fst, const TLocalShared& snd) noexcept {
+		return fst.m_ptr >= snd.m_ptr;
+	}
+
+	friend bool operator==(const TLocalShared& fst, const TLocalShared& snd) noexcept {
+		return fst.m_ptr == snd.m_ptr;
+	}
+
+	// Compare raw pointer
+	friend bool operator==(const TLocalShared& fst, const void* snd) noexcept {
+		return fst.m_ptr == snd;
+	}
+
+	friend bool operator!=(const TLocalShared& fst, const TLocalShared& snd) noexcept {
+		return fst.m_ptr != snd.m_ptr;
+	}
+
+	// Compare raw pointer
+	friend bool operator!=(const TLocalShared& fst, const void* snd) noexcept {
+		return fst.m_ptr != snd;
+	}
+
+	friend size_t getHash(const TLocalShared& obj) noexcept {
+		std::hash<TType*> ptrHash;
+		return ptrHash(obj.m_ptr);
+	}
+
+private:
+
+	template <typename>
+	friend struct TLocalShared;
+
+	template <typename>
+	friend struct TLocalWeak;
+
+	// Shares counts that already have a strong reference elsewhere, for casts and locking weak pointers
+	TLocalShared(sstl::SLocalCounts* counts, TType* ptr) noexcept
+	: m_ptr(ptr), m_Counts(counts) {
+		if (m_Counts) m_Counts->addStrong();
+	}
+
+	// Releasable types free themselves, so they are allocated apart from their counts
+	template <typename... TArgs>
+	void create(TArgs&&... args) {
+		using TNonConst = std::remove_const_t<TType>;
+		if constexpr (sstl::is_releasable_v<TNonConst>) {
+			auto* ptr = new TNonConst(std::forward<TArgs>(args)...);
+			m_Counts = new sstl::TLocalPointerCounts<TNonConst>(ptr);
+			m_ptr = ptr;
+		} else {
+			auto* counts = new sstl::TLocalInplaceCounts<TNonConst>(std::forward<TArgs>(args)...);
+			m_Counts = counts;
+			m_ptr = counts->get();
+		}
+		enableSharedFrom(m_ptr);
+		if constexpr (sstl::is_initializable_v<TType>) {
+			m_ptr->init();
+		}
+	}
+
+	// Picked for types deriving from TLocalSharedFrom, which are given a weak pointer to themselves
+	template <typename TSharedType, typename TPointerType>
+	void enableSharedFrom(const TLocalSharedFrom<TSharedType>* base, TPointerType* ptr) noexcept;
+
+	void enableSharedFrom(const volatile void*, const volatile void*) noexcept {}
+
+	template <typename TPointerType>
+	void enableSharedFrom(TPointerType* ptr) noexcept {
+		enableSharedFrom(ptr, ptr);
+	}
+
+	void reset() noexcept {
+		if (m_Counts) std::exchange(m_Counts, nullptr)->releaseStrong();
+		m_ptr = nullptr;
 	}
+
+	void swap(TLocalShared& otr) noexcept {
+		std::swap(m_ptr, otr.m_ptr);
+		std::swap(m_Counts, otr.m_Counts);
+	}
+
+	TType* m_ptr = nullptr;
+
+	sstl::SLocalCounts* m_Counts = nullptr;
 };
 
+// Template argument deduction for input of a single type
 template <typename TType>
-struct TUnfurled<TWeak<TType>> {
-	using Type = TType;
+TLocalShared(TType) -> TLocalShared<TType>;
+
+// TWeak for TLocalShared, checked against the same plain counts
+template <typename TType>
+struct TLocalWeak {
+
+	TLocalWeak() = default;
+
+	TLocalWeak(nullptr_t) noexcept {}
+
+	TLocalWeak& operator=(nullptr_t) noexcept {
+		reset();
+		return *this;
+	}
+
+	template <typename TOtherType,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	TLocalWeak(const TLocalShared<TOtherType>& shared) noexcept
+	: m_ptr(shared.m_ptr), m_Counts(shared.m_Counts) {
+		if (m_Counts) m_Counts->addWeak();
+	}
+
+	TLocalWeak(const TLocalWeak& otr) noexcept
+	: m_ptr(otr.m_ptr), m_Counts(otr.m_Counts) {
+		if (m_Counts) m_Counts->addWeak();
+	}
+
+	TLocalWeak(TLocalWeak&& otr) noexcept
+	: m_ptr(std::exchange(otr.m_ptr, nullptr)), m_Counts(std::exchange(otr.m_Counts, nullptr)) {}
+
+	~TLocalWeak() {
+		reset();
+	}
+
+	TLocalWeak& operator=(const TLocalWeak& otr) noexcept {
+		TLocalWeak(otr).swap(*this);
+		return *this;
+	}
+
+	TLocalWeak& operator=(TLocalWeak&& otr) noexcept {
+		TLocalWeak(std::move(otr)).swap(*this);
+		return *this;
+	}
+
+	// Resets weak pointer to an empty state, since this pointer has no ownership it will no destroy any objects
+	void destroy() noexcept {
+		reset();
+	}
+
+	template <typename TOtherType>
+	TLocalShared<TOtherType> staticCast() const noexcept {
+		return get().template staticCast<TOtherType>();
+	}
+
+	template <typename TOtherType>
+	TLocalShared<TOtherType> dynamicCast() const noexcept {
+		return get().template dynamicCast<TOtherType>();
+	}
+
+	template <typename TOtherType>
+	TLocalShared<TOtherType> reinterpretCast() const noexcept {
+		return get().template reinterpretCast<TOtherType>();
+	}
+
+	template <typename TOtherType>
+	TLocalShared<TOtherType> constCast() const noexcept {
+		return get().template constCast<TOtherType>();
+	}
+
+	operator TLocalShared<TType>() const noexcept {
+		return get();
+	}
+
+	TLocalShared<TType> operator->() const noexcept {
+		return get();
+	}
+
+	TLocalShared<TType> operator*() const noexcept {
+		return get();
+	}
+
+	// Empty once the object is gone
+	TLocalShared<TType> get() const noexcept {
+		if (*this) return TLocalShared<TType>(m_Counts, m_ptr);
+		return nullptr;
+	}
+
+	operator bool() const noexcept {
+		if (!m_Counts) return false;
+		m_Counts->checkThread();
+		return m_Counts->strong > 0;
+	}
+
+	// Ordered by the counts, as with TWeak, so a weak pointer keeps its place after the object is gone
+	friend bool operator<(const TLocalWeak& fst, const TLocalWeak& snd) noexcept {
+		return std::less<sstl::SLocalCounts*>()(fst.m_Counts, snd.m_Counts);
+	}
+
+	friend bool operator<=(const TLocalWeak& fst, const TLocalWeak& snd) noexcept {
+		return !(snd < fst);
+	}
+
+	friend bool operator>(const TLocalWeak& fst, const TLocalWeak& snd) noexcept {
+		return snd < fst;
+	}
+
+	friend bool operator>=(const TLocalWeak& fst, const TLocalWeak& snd) noexcept {
+		return !(fst < snd);
+	}
+
+	friend bool operator==(const TLocalWeak& fst, const TLocalWeak& snd) noexcept {
+		return fst.m_Counts == snd.m_Counts;
+	}
+
+	// Compare raw pointer
+	friend bool operator==(const TLocalWeak& fst, const void* snd) noexcept {
+		return fst && fst.m_ptr == snd;
+	}
+
+	friend bool operator!=(const TLocalWeak& fst, const TLocalWeak& snd) noexcept {
+		return fst.m_Counts != snd.m_Counts;
+	}
+
+	// Compare raw pointer
+	friend bool operator!=(const TLocalWeak& fst, const void* snd) noexcept {
+		return !fst || fst.m_ptr != snd;
+	}
+
+	friend size_t getHash(const TLocalWeak& obj) noexcept {
+		if (obj) {
+			std::hash<TType*> ptrHash;
+			return ptrHash(obj.m_ptr);
+		}
+		return 0;
+	}
+
+private:
+
+	template <typename>
+	friend struct TLocalShared;
+
+	template <typename>
+	friend struct TLocalWeak;
+
+	template <typename>
+	friend struct TLocalSharedFrom;
+
+	TLocalWeak(sstl::SLocalCounts* counts, TType* ptr) noexcept
+	: m_ptr(ptr), m_Counts(counts) {
+		if (m_Counts) m_Counts->addWeak();
+	}
+
+	void reset() noexcept {
+		if (m_Counts) std::exchange(m_Counts, nullptr)->releaseWeak();
+		m_ptr = nullptr;
+	}
+
+	void swap(TLocalWeak& otr) noexcept {
+		std::swap(m_ptr, otr.m_ptr);
+		std::swap(m_Counts, otr.m_Counts);
+	}
+
+	TType* m_ptr = nullptr;
+
+	sstl::SLocalCounts* m_Counts = nullptr;
+};
+
+template <typename TType>
+template <typename TOtherType>
+TLocalShared<TType>::TLocalShared(const TLocalWeak<TOtherType>& weak) noexcept {
+	if (weak) {
+		m_ptr = weak.m_ptr;
+		m_Counts = weak.m_Counts;
+		m_Counts->addStrong();
+	}
+}
+
+// TSharedFrom for TLocalShared, set up whenever a TLocalShared takes ownership of the object
+template <typename TType>
+struct TLocalSharedFrom {
+
+	_NODISCARD TLocalShared<TType> getShared() {
+		return m_Weak.get();
+	}
+
+	_NODISCARD TLocalShared<const TType> getShared() const {
+		return m_Weak.get().template constCast<const TType>();
+	}
+
+	_NODISCARD TLocalWeak<TType> getWeak() noexcept {
+		return m_Weak;
+	}
+
+protected:
+	constexpr TLocalSharedFrom() noexcept = default;
+
+	TLocalSharedFrom(const TLocalSharedFrom&) noexcept {}
+
+	TLocalSharedFrom& operator=(const TLocalSharedFrom&) noexcept {
+		return *this;
+	}
+
+	~TLocalSharedFrom() = default;
+
+private:
+	template <typename>
+	friend struct TLocalShared;
+
+	mutable TLocalWeak<TType> m_Weak;
+};
+
+template <typename TType>
+template <typename TSharedType, typename TPointerType>
+void TLocalShared<TType>::enableSharedFrom(const TLocalSharedFrom<TSharedType>* base, TPointerType* ptr) noexcept {
+	// Only the first owner sets it, so taking ownership of the same object twice can't point it at the wrong counts
+	if (!base->m_Weak) {
+		base->m_Weak = TLocalWeak<TSharedType>(m_Counts, const_cast<std::remove_const_t<TSharedType>*>(static_cast<const TSharedType*>(ptr)));
+	}
+}
+
+// Gives a type the addRef and releaseRef TIntrusive needs, keeping the count in the object itself
+// The count starts at zero, so the first TIntrusive to take the object becomes its owner
+template <typename TType>
+struct TRefCounted {
+
+	void addRef() const noexcept {
+		m_RefCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void releaseRef() const noexcept {
+		const size_t previous = m_RefCount.fetch_sub(1, std::memory_order_acq_rel);
+		assert(previous > 0 && "Released a reference that was never added!");
+		if (previous == 1) {
+			TType* ptr = const_cast<TType*>(static_cast<const TType*>(this));
+			if constexpr (sstl::is_destroyable_v<TType>) {
+				ptr->destroy();
+			}
+			delete ptr;
+		}
+	}
+
+	size_t getRefCount() const noexcept {
+		return m_RefCount.load(std::memory_order_relaxed);
+	}
+
+protected:
+	constexpr TRefCounted() noexcept = default;
+
+	// A copy is a new object, so it starts without any references
+	TRefCounted(const TRefCounted&) noexcept {}
+
+	TRefCounted& operator=(const TRefCounted&) noexcept {
+		return *this;
+	}
+
+	~TRefCounted() = default;
+
+private:
+	mutable std::atomic<size_t> m_RefCount{0};
+};
+
+// A shared pointer for types that count their own references, either through TRefCounted or their own addRef and releaseRef
+// It is only as large as a raw pointer, and can be made from a raw pointer at any time, including this
+template <typename TType>
+struct TIntrusive {
+
+	static_assert(sstl::is_ref_counted_v<std::remove_const_t<TType>>, "TIntrusive needs a type with addRef and releaseRef!");
+
+	TIntrusive() noexcept {
+		// If not default constructible, default to nullptr
+		if constexpr (std::is_default_constructible_v<TType>) {
+			create();
+		}
+	}
+
+	TIntrusive(nullptr_t) noexcept {}
+
+	TIntrusive& operator=(nullptr_t) noexcept {
+		reset();
+		return *this;
+	}
+
+	// Shares ownership with every other TIntrusive to the object, since the count lives in the object
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	explicit TIntrusive(TOtherType* ptr) noexcept
+	: m_ptr(ptr) {
+		addRef();
+	}
+
+	template <typename... TArgs,
+		std::enable_if_t<
+			std::conjunction_v<
+				std::negation<std::is_null_pointer<std::decay_t<TArgs>>>...,
+				std::negation<std::is_convertible<std::decay_t<TArgs>, TType*>>...,
+				std::negation<sstl::is_managed<std::decay_t<TArgs>>>...
+			>,
+			int> = 0
+	>
+	explicit TIntrusive(TArgs&&... args) noexcept {
+		create(std::forward<TArgs>(args)...);
+	}
+
+	TIntrusive(const TIntrusive& otr) noexcept
+	: m_ptr(otr.m_ptr) {
+		addRef();
+	}
+
+	// Non-const lvalues would otherwise be taken by the variadic constructor, and copied into a new object
+	TIntrusive(TIntrusive& otr) noexcept
+	: TIntrusive(std::as_const(otr)) {}
+
+	TIntrusive(TIntrusive&& otr) noexcept
+	: m_ptr(std::exchange(otr.m_ptr, nullptr)) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_same<TOtherType, TType>>, std::is_convertible<TOtherType*, TType*>>, int> = 0
+	>
+	TIntrusive(const TIntrusive<TOtherType>& otr) noexcept
+	: m_ptr(otr.m_ptr) {
+		addRef();
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_same<TOtherType, TType>>, std::is_convertible<TOtherType*, TType*>>, int> = 0
+	>
+	TIntrusive(TIntrusive<TOtherType>& otr) noexcept
+	: TIntrusive(std::as_const(otr)) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_same<TOtherType, TType>>, std::is_convertible<TOtherType*, TType*>>, int> = 0
+	>
+	TIntrusive(TIntrusive<TOtherType>&& otr) noexcept
+	: m_ptr(std::exchange(otr.m_ptr, nullptr)) {}
+
+	~TIntrusive() {
+		reset();
+	}
+
+	TIntrusive& operator=(const TIntrusive& otr) noexcept {
+		TIntrusive(otr).swap(*this);
+		return *this;
+	}
+
+	TIntrusive& operator=(TIntrusive&& otr) noexcept {
+		TIntrusive(std::move(otr)).swap(*this);
+		return *this;
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_same<TOtherType, TType>>, std::is_convertible<TOtherType*, TType*>>, int> = 0
+	>
+	TIntrusive& operator=(const TIntrusive<TOtherType>& otr) noexcept {
+		TIntrusive(otr).swap(*this);
+		return *this;
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_same<TOtherType, TType>>, std::is_convertible<TOtherType*, TType*>>, int> = 0
+	>
+	TIntrusive& operator=(TIntrusive<TOtherType>&& otr) noexcept {
+		TIntrusive(std::move(otr)).swap(*this);
+		return *this;
+	}
+
+	// Releases ownership of the pointer, note the object will not be destroyed unless all other references are
+	void destroy() noexcept {
+		reset();
+	}
+
+	template <typename TOtherType>
+	TIntrusive<TOtherType> staticCast() const noexcept {
+		return TIntrusive<TOtherType>(static_cast<TOtherType*>(m_ptr));
+	}
+
+	template <typename TOtherType>
+	TIntrusive<TOtherType> dynamicCast() const noexcept {
+		if (auto ptr = dynamic_cast<TOtherType*>(m_ptr)) {
+			return TIntrusive<TOtherType>(ptr);
+		}
+		return nullptr;
+	}
+
+	template <typename TOtherType>
+	TIntrusive<TOtherType> reinterpretCast() const noexcept {
+		return TIntrusive<TOtherType>(reinterpret_cast<TOtherType*>(m_ptr));
+	}
+
+	template <typename TOtherType>
+	TIntrusive<TOtherType> constCast() const noexcept {
+		return TIntrusive<TOtherType>(const_cast<TOtherType*>(m_ptr));
+	}
+
+	TType* operator->() const noexcept {
+		return m_ptr;
+	}
+
+	TType& operator*() const noexcept {
+		return *m_ptr;
+	}
+
+	TType* get() const noexcept { return m_ptr; }
+
+	operator bool() const noexcept {
+		return m_ptr != nullptr;
+	}
+
+	friend bool operator<(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr < snd.m_ptr;
+	}
+
+	friend bool operator<=(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr <= snd.m_ptr;
+	}
+
+	friend bool operator>(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr > snd.m_ptr;
+	}
+
+	friend bool operator>=(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr >= snd.m_ptr;
+	}
+
+	friend bool operator==(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr == snd.m_ptr;
+	}
+
+	// Compare raw pointer
+	friend bool operator==(const TIntrusive& fst, const void* snd) noexcept {
+		return fst.m_ptr == snd;
+	}
+
+	friend bool operator!=(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr != snd.m_ptr;
+	}
+
+	// Compare raw pointer
+	friend bool operator!=(const TIntrusive& fst, const void* snd) noexcept {
+		return fst.m_ptr != snd;
+	}
+
+	friend size_t getHash(const TIntrusive& obj) noexcept {
+		std::hash<TType*> ptrHash;
+		return ptrHash(obj.m_ptr);
+	}
+
+private:
+
+	template <typename>
+	friend struct TIntrusive;
+
+	template <typename... TArgs>
+	void create(TArgs&&... args) {
+		m_ptr = new std::remove_const_t<TType>(std::forward<TArgs>(args)...);
+		if constexpr (sstl::is_initializable_v<TType>) {
+			m_ptr->init();
+		}
+		addRef();
+	}
+
+	// The count is not part of the object's value, so a const object is still counted
+	void addRef() const noexcept {
+		if (m_ptr) const_cast<std::remove_const_t<TType>*>(m_ptr)->addRef();
+	}
+
+	void reset() noexcept {
+		if (m_ptr) const_cast<std::remove_const_t<TType>*>(std::exchange(m_ptr, nullptr))->releaseRef();
+	}
+
+	void swap(TIntrusive& otr) noexcept {
+		std::swap(m_ptr, otr.m_ptr);
+	}
+
+	TType* m_ptr = nullptr;
+};
+
+// Template argument deduction for a raw pointer, such as this
+template <typename TType>
+TIntrusive(TType*) -> TIntrusive<TType>;
+
+template <typename>
+struct TObjectPool;
+
+template <typename TType>
+struct TUnfurled {
+	using Type = TType;
+	constexpr static bool isManaged = false;
+
+	template <typename TOtherType = TType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType, TType>, int> = 0
+	>
+	constexpr static TType create(TArgs&&... args)
+#if CXX_VERSION >= 20
+noexcept(std::is_nothrow_convertible_v<TOtherType, TType>) {
+#else
+noexcept {
+#endif
+		TOtherType obj{std::forward<TArgs>(args)...};
+		if constexpr (sstl::is_initializable_v<TOtherType>) {
+			obj.init();
+		}
+		return obj;
+	}
+};
+
+template <typename TType>
+struct TUnfurled<TShared<TType>> {
+	using Type = TType;
+	constexpr static bool isManaged = true;
+	constexpr static auto get = &TShared<TType>::get;
+
+	template <typename TOtherType = TType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 static TShared<TType> create(TArgs&&... args)
+#if CXX_VERSION >= 20
+	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
+#else
+	noexcept {
+#endif
+		return TShared<TOtherType>(std::forward<TArgs>(args)...);
+	}
+
+	// Takes the object's memory from a pool, see ObjectPool.h
+	template <typename TOtherType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	static TShared<TType> create(TObjectPool<TOtherType>& pool, TArgs&&... args) {
+		return pool.makeShared(std::forward<TArgs>(args)...);
+	}
+};
+
+template <typename TType>
+struct TUnfurled<TUnique<TType>> {
+	using Type = TType;
+	constexpr static bool isManaged = true;
+	constexpr static auto get = &TUnique<TType>::get;
+
+	template <typename TOtherType = TType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 static TUnique<TType> create(TArgs&&... args)
+#if CXX_VERSION >= 20
+	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
+#else
+	noexcept {
+#endif
+		return TUnique<TOtherType>(std::forward<TArgs>(args)...);
+	}
+
+	// Takes the object's memory from a pool, see ObjectPool.h
+	template <typename TOtherType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	static TUnique<TType> create(TObjectPool<TOtherType>& pool, TArgs&&... args) {
+		return pool.makeUnique(std::forward<TArgs>(args)...);
+	}
+};
+
+template <typename TType>
+struct TUnfurled<TWeak<TType>> {
+	using Type = TType;
 	constexpr static bool isManaged = true;
 	constexpr static auto get = &TWeak<TType>::get;
 };
@@ -1150,6 +2055,41 @@ struct TUnfurled<TFrail<TType>> {
 	constexpr static auto get = &TFrail<TType>::get;
 };
 
+template <typename TType>
+struct TUnfurled<TLocalShared<TType>> {
+	using Type = TType;
+	constexpr static bool isManaged = true;
+	constexpr static auto get = &TLocalShared<TType>::get;
+
+	template <typename TOtherType = TType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	static TLocalShared<TType> create(TArgs&&... args) noexcept {
+		return TLocalShared<TOtherType>(std::forward<TArgs>(args)...);
+	}
+};
+
+template <typename TType>
+struct TUnfurled<TLocalWeak<TType>> {
+	using Type = TType;
+	constexpr static bool isManaged = true;
+	constexpr static auto get = &TLocalWeak<TType>::get;
+};
+
+template <typename TType>
+struct TUnfurled<TIntrusive<TType>> {
+	using Type = TType;
+	constexpr static bool isManaged = true;
+	constexpr static auto get = &TIntrusive<TType>::get;
+
+	template <typename TOtherType = TType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	static TIntrusive<TType> create(TArgs&&... args) noexcept {
+		return TIntrusive<TOtherType>(std::forward<TArgs>(args)...);
+	}
+};
+
 /*
  * Determine whether TType is a managed pointer or not
  */
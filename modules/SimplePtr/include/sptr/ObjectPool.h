@@ -0,0 +1,337 @@
+﻿#pragma once
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Memory.h"
+
+namespace sstl {
+
+	// The memory behind a pool, shared with every thread caching blocks from it, so it outlives the pool until they let go
+	struct SPoolCentral {
+
+		explicit SPoolCentral(const size_t inBlockSize, const size_t inBlockAlign, const size_t inSlabSize) noexcept
+		: blockSize(inBlockSize), blockAlign(inBlockAlign), slabSize(inSlabSize) {}
+
+		SPoolCentral(const SPoolCentral&) = delete;
+
+		SPoolCentral& operator=(const SPoolCentral&) = delete;
+
+		~SPoolCentral() {
+			for (void* slab : slabs) {
+				unmap(slab, slabSize);
+			}
+		}
+
+		// Moves up to count blocks into out, carving a new slab when there are none free
+		size_t take(void** out, const size_t count) {
+			std::lock_guard lock(mutex);
+			size_t taken = 0;
+			for (; taken < count && freeList; ++taken) {
+				out[taken] = std::exchange(freeList, *static_cast<void**>(freeList));
+			}
+			for (; taken < count; ++taken) {
+				if (next == end) carve();
+				out[taken] = next;
+				next += blockSize;
+			}
+			return taken;
+		}
+
+		void give(void* const* blocks, const size_t count) noexcept {
+			std::lock_guard lock(mutex);
+			for (size_t i = 0; i < count; ++i) {
+				*static_cast<void**>(blocks[i]) = freeList;
+				freeList = blocks[i];
+			}
+		}
+
+		static SPoolCentral* find(const void* block, const size_t slabSize) noexcept {
+			// Slabs are aligned to their size, so the start of one, where its owner is written, is found by masking
+			return *reinterpret_cast<SPoolCentral* const*>(reinterpret_cast<uintptr_t>(block) & ~(static_cast<uintptr_t>(slabSize) - 1));
+		}
+
+		const size_t blockSize;
+		const size_t blockAlign;
+		const size_t slabSize;
+
+	private:
+		void carve() {
+			slabs.reserve(slabs.size() + 1);
+			unsigned char* slab;
+			slabs.push_back(map(slabSize, slab));
+			*reinterpret_cast<SPoolCentral**>(slab) = this;
+			const size_t header = (sizeof(SPoolCentral*) + blockAlign - 1) / blockAlign * blockAlign;
+			next = slab + header;
+			end = next + (slabSize - header) / blockSize * blockSize;
+		}
+
+		// Maps a slab aligned to its size from the OS, as aligned operator new may waste up to half of it doing the same
+		// Returns what unmap needs to give it back, which is not always where the slab starts
+		static void* map(const size_t size, unsigned char*& slab) {
+#ifdef _WIN32
+			// Allocations start on 64KiB boundaries, so slabs that size are already aligned
+			void* base = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			if (base && reinterpret_cast<uintptr_t>(base) % size == 0) {
+				slab = static_cast<unsigned char*>(base);
+				return base;
+			}
+			if (base) VirtualFree(base, 0, MEM_RELEASE);
+			// Larger ones reserve twice their size, and only commit the aligned part of it
+			base = VirtualAlloc(nullptr, size * 2, MEM_RESERVE, PAGE_NOACCESS);
+			if (!base) throw std::bad_alloc();
+			slab = reinterpret_cast<unsigned char*>((reinterpret_cast<uintptr_t>(base) + size - 1) & ~(static_cast<uintptr_t>(size) - 1));
+			if (!VirtualAlloc(slab, size, MEM_COMMIT, PAGE_READWRITE)) {
+				VirtualFree(base, 0, MEM_RELEASE);
+				throw std::bad_alloc();
+			}
+			return base;
+#else
+			void* base = mmap(nullptr, size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (base == MAP_FAILED) throw std::bad_alloc();
+			const uintptr_t start = reinterpret_cast<uintptr_t>(base);
+			const uintptr_t aligned = (start + size - 1) & ~(static_cast<uintptr_t>(size) - 1);
+			// Gives back what was mapped either side of the slab
+			if (aligned != start) munmap(base, aligned - start);
+			if (aligned != start + size) munmap(reinterpret_cast<void*>(aligned + size), start + size - aligned);
+			slab = reinterpret_cast<unsigned char*>(aligned);
+			return slab;
+#endif
+		}
+
+		static void unmap(void* base, const size_t size) noexcept {
+#ifdef _WIN32
+			(void)size;
+			VirtualFree(base, 0, MEM_RELEASE);
+#else
+			munmap(base, size);
+#endif
+		}
+
+		std::mutex mutex;
+		void* freeList = nullptr;
+		unsigned char* next = nullptr;
+		unsigned char* end = nullptr;
+		std::vector<void*> slabs;
+	};
+
+	// Blocks a thread holds on to for one pool, so most allocations and frees never take the lock
+	template <size_t TSize>
+	struct TPoolCache {
+
+		TPoolCache() = default;
+
+		TPoolCache(const TPoolCache&) = delete;
+
+		TPoolCache& operator=(const TPoolCache&) = delete;
+
+		~TPoolCache() {
+			bind(nullptr);
+		}
+
+		// Returns what the cache holds to the pool it held them for before switching to another
+		void bind(std::shared_ptr<SPoolCentral> inCentral) noexcept {
+			if (central) central->give(blocks, count);
+			count = 0;
+			central = std::move(inCentral);
+		}
+
+		std::shared_ptr<SPoolCentral> central;
+		void* blocks[TSize];
+		size_t count = 0;
+	};
+
+	template <typename TType>
+	void pool_delete_impl(void* ptr) noexcept;
+}
+
+// Hands out memory for one type from large aligned slabs, recycling every freed block for the next object
+// Each thread caches blocks from the last pool it allocated from, and only locks the pool to refill or drain that cache
+// Objects must all be freed before the pool is destroyed
+template <typename TType>
+struct TObjectPool {
+
+	static_assert(!sstl::is_releasable_v<TType>, "Releasable types free themselves, so can't be returned to a pool!");
+
+	constexpr static size_t BLOCK_ALIGN = alignof(TType) > alignof(void*) ? alignof(TType) : alignof(void*);
+
+	// Every free block holds the next one in the free list
+	constexpr static size_t BLOCK_SIZE = ((sizeof(TType) > sizeof(void*) ? sizeof(TType) : sizeof(void*)) + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+
+	constexpr static size_t CACHE_SIZE = 64;
+
+	// At least 64KiB, and a power of two, as slabs are found by masking off the low bits of a block
+	constexpr static size_t SLAB_SIZE = [] {
+		size_t size = 64 * 1024;
+		while (size < BLOCK_ALIGN + BLOCK_SIZE * CACHE_SIZE) size *= 2;
+		return size;
+	}();
+
+	TObjectPool()
+	: m_Central(std::make_shared<sstl::SPoolCentral>(BLOCK_SIZE, BLOCK_ALIGN, SLAB_SIZE)) {}
+
+	TObjectPool(const TObjectPool&) = delete;
+
+	TObjectPool& operator=(const TObjectPool&) = delete;
+
+	// Pools made on first use for each type, and never destroyed, so objects may be freed to them during shutdown
+	// Once a thread's cache has been destroyed, its frees go straight to the pool, see isCacheDestroyed
+	static TObjectPool& getDefault() {
+		static TObjectPool* pool = new TObjectPool();
+		return *pool;
+	}
+
+	void* allocate() {
+		if (isCacheDestroyed()) {
+			void* block;
+			m_Central->take(&block, 1);
+			return block;
+		}
+		auto& cache = getCache();
+		if (cache.central.get() != m_Central.get()) {
+			cache.bind(m_Central);
+		}
+		if (cache.count == 0) {
+			cache.count = m_Central->take(cache.blocks, CACHE_SIZE / 2);
+		}
+		return cache.blocks[--cache.count];
+	}
+
+	// Goes back to the pool it came from, which does not have to be the one this thread is caching for
+	static void deallocate(void* ptr) noexcept {
+		sstl::SPoolCentral* central = sstl::SPoolCentral::find(ptr, SLAB_SIZE);
+		if (isCacheDestroyed()) {
+			central->give(&ptr, 1);
+			return;
+		}
+		auto& cache = getCache();
+		if (cache.central.get() != central) {
+			central->give(&ptr, 1);
+			return;
+		}
+		if (cache.count == CACHE_SIZE) {
+			// Keeps half, so a thread switching between allocating and freeing doesn't lock every time
+			central->give(cache.blocks + CACHE_SIZE / 2, CACHE_SIZE / 2);
+			cache.count = CACHE_SIZE / 2;
+		}
+		cache.blocks[cache.count++] = ptr;
+	}
+
+	template <typename... TArgs>
+	TType* create(TArgs&&... args) {
+		void* memory = allocate();
+		TType* ptr;
+		try {
+			ptr = ::new (memory) TType(std::forward<TArgs>(args)...);
+		} catch (...) {
+			deallocate(memory);
+			throw;
+		}
+		if constexpr (sstl::is_initializable_v<TType>) {
+			ptr->init();
+		}
+		return ptr;
+	}
+
+	// Destroys an object made by any pool of this type
+	static void free(TType* ptr) noexcept {
+		if constexpr (sstl::is_destroyable_v<TType>) {
+			ptr->destroy();
+		}
+		ptr->~TType();
+		deallocate(ptr);
+	}
+
+	template <typename... TArgs>
+	TUnique<TType> makeUnique(TArgs&&... args) {
+		return TUnique<TType>(std::unique_ptr<TType, sstl::delayed_deleter<TType>>(create(std::forward<TArgs>(args)...), sstl::delayed_deleter<TType>(&sstl::pool_delete_impl<TType>)));
+	}
+
+	// The control block is pooled as well, in the default pool for its type
+	template <typename... TArgs>
+	TShared<TType> makeShared(TArgs&&... args);
+
+private:
+	// Other thread_local and static destructors can still free objects after the cache is gone, so it marks when it is
+	struct SCache : sstl::TPoolCache<CACHE_SIZE> {
+		~SCache() {
+			isCacheDestroyed() = true;
+		}
+	};
+
+	static SCache& getCache() noexcept {
+		thread_local SCache cache;
+		return cache;
+	}
+
+	// Has no destructor, so unlike the cache it can still be read while the thread or program is exiting
+	static bool& isCacheDestroyed() noexcept {
+		thread_local bool destroyed = false;
+		return destroyed;
+	}
+
+	std::shared_ptr<sstl::SPoolCentral> m_Central;
+};
+
+namespace sstl {
+
+	template <typename TType>
+	void pool_delete_impl(void* ptr) noexcept {
+		TObjectPool<TType>::free(static_cast<TType*>(ptr));
+	}
+
+	template <typename TType>
+	struct pool_deleter {
+		void operator()(TType* ptr) const noexcept {
+			TObjectPool<TType>::free(ptr);
+		}
+	};
+
+	// Draws single objects from the default pool of whatever type it is rebound to, such as a control block
+	template <typename TType>
+	struct pool_allocator {
+		using value_type = TType;
+
+		constexpr pool_allocator() noexcept = default;
+
+		template <typename TOtherType>
+		constexpr pool_allocator(const pool_allocator<TOtherType>&) noexcept {}
+
+		TType* allocate(const size_t count) {
+			if (count == 1) return static_cast<TType*>(TObjectPool<TType>::getDefault().allocate());
+			return std::allocator<TType>().allocate(count);
+		}
+
+		void deallocate(TType* ptr, const size_t count) noexcept {
+			if (count == 1) TObjectPool<TType>::deallocate(ptr);
+			else std::allocator<TType>().deallocate(ptr, count);
+		}
+
+		template <typename TOtherType>
+		friend bool operator==(const pool_allocator&, const pool_allocator<TOtherType>&) noexcept {
+			return true;
+		}
+
+		template <typename TOtherType>
+		friend bool operator!=(const pool_allocator&, const pool_allocator<TOtherType>&) noexcept {
+			return false;
+		}
+	};
+}
+
+template <typename TType>
+template <typename... TArgs>
+TShared<TType> TObjectPool<TType>::makeShared(TArgs&&... args) {
+	return TShared<TType>(std::shared_ptr<TType>(create(std::forward<TArgs>(args)...), sstl::pool_deleter<TType>(), sstl::pool_allocator<TType>()));
+}
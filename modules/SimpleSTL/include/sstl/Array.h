@@ -1,7 +1,9 @@
 ﻿#pragma once
 
+#include <algorithm>
 #include <array>
 #include "Container.h"
+#include "Execution.h"
 #include "sutil/InitializerList.h"
 
 template <typename TType, size_t TSize>
@@ -43,7 +45,7 @@ struct TArray : TSequenceContainer<TType> {
 		m_IsPopulated.fill(true);
 	}
 
-	[[nodiscard]] virtual size_t getSize() const override {
+	[[nodiscard]] virtual size_t getSize() const override STATIC_DISPATCH {
 		return m_Container.size();
 	}
 
@@ -51,19 +53,19 @@ struct TArray : TSequenceContainer<TType> {
 
 	const TType* data() const { return m_Container.data(); }
 
-	virtual TType& top() override {
+	virtual TType& top() override STATIC_DISPATCH {
 		return m_Container.front();
 	}
 
-	virtual const TType& top() const override {
+	virtual const TType& top() const override STATIC_DISPATCH {
 		return m_Container.front();
 	}
 
-	virtual TType& bottom() override {
+	virtual TType& bottom() override STATIC_DISPATCH {
 		return m_Container.back();
 	}
 
-	virtual const TType& bottom() const override {
+	virtual const TType& bottom() const override STATIC_DISPATCH {
 		return m_Container.back();
 	}
 
@@ -105,17 +107,26 @@ struct TArray : TSequenceContainer<TType> {
 		}
 	}
 
-	virtual TType& get(size_t index) override {
+	virtual TType& get(size_t index) override STATIC_DISPATCH {
 		return m_Container[index];
 	}
 
-	virtual const TType& get(size_t index) const override {
+	virtual const TType& get(size_t index) const override STATIC_DISPATCH {
 		return m_Container[index];
 	}
 
+	virtual TType& operator[](const size_t index) override STATIC_DISPATCH {
+		return m_Container[index];
+	}
+
+	virtual const TType& operator[](const size_t index) const override STATIC_DISPATCH {
+		return m_Container[index];
+	}
+
+	// Anything past TSize is ignored, as the array can never hold more
 	virtual void resize(size_t amt) override {
 		if constexpr (std::is_default_constructible_v<TType>) {
-			for (size_t i = 0; i < amt; ++i) {
+			for (size_t i = 0; i < std::min(amt, TSize); ++i) {
 				if (!m_IsPopulated[i]) {
 					m_Container[i] = {};
 					m_IsPopulated[i] = true;
@@ -127,7 +138,7 @@ struct TArray : TSequenceContainer<TType> {
 	}
 
 	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
-		for (size_t i = 0; i < amt; ++i) {
+		for (size_t i = 0; i < std::min(amt, TSize); ++i) {
 			if (!m_IsPopulated[i]) {
 				get(i) = std::forward<TType>(func(i));
 				m_IsPopulated[i] = true;
@@ -253,34 +264,162 @@ struct TArray : TSequenceContainer<TType> {
 		}
 	}
 
-	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
+	virtual void forEach(const std::function<void(size_t, TType&)>& func) override STATIC_DISPATCH {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override STATIC_DISPATCH {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override STATIC_DISPATCH {
+		size_t i = getSize() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override STATIC_DISPATCH {
+		size_t i = getSize() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
-	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
-	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
 		size_t i = getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
-	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
 		size_t i = getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
+	using TSequenceContainer<TType>::doFor;
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	// Overloads taking sstl::execution::seq, par or par_unseq, the parallel policies split the work between the threads of the shared pool
+	// Each element is given the same index as in the serial version, though the calls happen in no particular order
+	template <typename TPolicy, typename TFunc,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	void forEach(TPolicy&& policy, TFunc&& func) {
+		sstl::execution::forChunks(policy, m_Container.size(), [&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				func(i, m_Container[i]);
+			}
+		});
+	}
+
+	template <typename TPolicy, typename TFunc,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	void forEach(TPolicy&& policy, TFunc&& func) const {
+		sstl::execution::forChunks(policy, m_Container.size(), [&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				func(i, m_Container[i]);
+			}
+		});
+	}
+
+	// Always the first match, no matter which thread finds it
+	template <typename TPolicy,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	[[nodiscard]] size_t find(TPolicy&& policy, const TType& obj) const {
+		if constexpr (sutil::is_equality_comparable_v<TType>) {
+			return sstl::execution::findFirst(policy, m_Container.size(), [&](const size_t i) { return m_Container[i] == obj; });
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	template <typename TPolicy,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	[[nodiscard]] bool contains(TPolicy&& policy, const TType& obj) const {
+		return find(policy, obj) != m_Container.size();
+	}
+
+	// Every slot below amt is independent, so func(i) can fill them from any thread
+	template <typename TPolicy, typename TFunc,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	void resize(TPolicy&& policy, const size_t amt, TFunc&& func) {
+		sstl::execution::forChunks(policy, std::min(amt, TSize), [&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				if (!m_IsPopulated[i]) {
+					m_Container[i] = func(i);
+					m_IsPopulated[i] = true;
+				}
+			}
+		});
+	}
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	using value_type = typename std::array<TType, TSize>::value_type;
+	using iterator = typename std::array<TType, TSize>::iterator;
+	using const_iterator = typename std::array<TType, TSize>::const_iterator;
+	using reverse_iterator = typename std::array<TType, TSize>::reverse_iterator;
+	using const_reverse_iterator = typename std::array<TType, TSize>::const_reverse_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
 protected:
 
 	void arrayArgsInit(const TType& obj, size_t& index) noexcept {
@@ -0,0 +1,213 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sstl {
+	// Kept as a constant rather than std::hardware_destructive_interference_size, which not every standard library has and some warn about using
+	inline constexpr size_t CACHE_LINE_SIZE = 64;
+}
+
+// A bounded queue that any number of threads can push to and pop from at once without taking a lock
+// Each cell carries a sequence number saying whether it is ready to be pushed to or popped from on the current lap around the ring
+// Pushing claims a position with a single compare and swap, and only cells that are ready are ever claimed, so threads never wait on each other
+// Based on Dmitry Vyukov's bounded MPMC queue
+template <typename TType, typename TAllocator = std::allocator<TType>>
+class TConcurrentQueue {
+
+	// A claimed cell has to be filled or emptied before anyone else can use it, so moving an element in or out must not throw
+	static_assert(std::is_nothrow_move_constructible_v<TType> && std::is_nothrow_destructible_v<TType>, "TConcurrentQueue requires a type that can be moved and destroyed without throwing");
+
+	struct SCell {
+		std::atomic<size_t> sequence{0};
+		alignas(TType) unsigned char storage[sizeof(TType)];
+
+		TType* get() { return std::launder(reinterpret_cast<TType*>(storage)); }
+	};
+
+	using CellAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<SCell>;
+	using CellTraits = std::allocator_traits<CellAllocator>;
+
+public:
+
+	// The capacity is rounded up to a power of two, of at least two
+	explicit TConcurrentQueue(const size_t capacity, const TAllocator& allocator = TAllocator())
+	: m_Allocator(allocator),
+	  m_Mask(roundCapacity(capacity) - 1) {
+		m_Cells = CellTraits::allocate(m_Allocator, getCapacity());
+		for (size_t i = 0; i < getCapacity(); ++i) {
+			CellTraits::construct(m_Allocator, m_Cells + i);
+			m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	TConcurrentQueue(const TConcurrentQueue&) = delete;
+	TConcurrentQueue& operator=(const TConcurrentQueue&) = delete;
+
+	~TConcurrentQueue() {
+		// No other thread can be pushing or popping anymore, so everything between the two positions is filled
+		const size_t enqueuePos = m_EnqueuePos.load(std::memory_order_acquire);
+		for (size_t pos = m_DequeuePos.load(std::memory_order_acquire); pos != enqueuePos; ++pos) {
+			std::destroy_at(m_Cells[pos & m_Mask].get());
+		}
+		for (size_t i = 0; i < getCapacity(); ++i) {
+			CellTraits::destroy(m_Allocator, m_Cells + i);
+		}
+		CellTraits::deallocate(m_Allocator, m_Cells, getCapacity());
+	}
+
+	[[nodiscard]] TAllocator getAllocator() const { return TAllocator(m_Allocator); }
+
+	[[nodiscard]] size_t getCapacity() const {
+		return m_Mask + 1;
+	}
+
+	// Only a snapshot, other threads may have pushed or popped by the time it returns
+	[[nodiscard]] size_t getSize() const {
+		const size_t dequeuePos = m_DequeuePos.load(std::memory_order_relaxed);
+		const size_t enqueuePos = m_EnqueuePos.load(std::memory_order_relaxed);
+		return enqueuePos > dequeuePos ? std::min(enqueuePos - dequeuePos, getCapacity()) : 0;
+	}
+
+	// Returns false if the queue is full, in which case obj is left as it was
+	bool tryPush(const TType& obj) {
+		if constexpr (std::is_nothrow_copy_constructible_v<TType>) {
+			return emplaceInCell(obj);
+		} else {
+			// Copied before a cell is claimed, so a copy that throws leaves the queue as it was
+			TType copy(obj);
+			return emplaceInCell(std::move(copy));
+		}
+	}
+
+	// Returns false if the queue is full, in which case obj is not moved from
+	bool tryPush(TType&& obj) {
+		return emplaceInCell(std::move(obj));
+	}
+
+	template <typename... TArgs>
+	bool tryEmplace(TArgs&&... args) {
+		if constexpr (std::is_nothrow_constructible_v<TType, TArgs&&...>) {
+			return emplaceInCell(std::forward<TArgs>(args)...);
+		} else {
+			TType obj(std::forward<TArgs>(args)...);
+			return emplaceInCell(std::move(obj));
+		}
+	}
+
+	// Returns false if the queue is empty, leaving obj as it was
+	bool tryPop(TType& obj) {
+		size_t pos;
+		if (claim(m_DequeuePos, 1, 1, pos) == 0) return false;
+
+		// Moved out and the cell handed back before assigning, so an assignment that throws can't leave the cell claimed
+		TType popped = takeFromCell(pos);
+		obj = std::move(popped);
+		return true;
+	}
+
+	// Moves up to count elements in with a single claim, returning how many were pushed
+	// Fewer are pushed when the queue fills up, the elements from that point on are not moved from
+	size_t tryPushRange(TType* objs, const size_t count) {
+		size_t pos;
+		const size_t claimed = claim(m_EnqueuePos, 0, count, pos);
+		for (size_t i = 0; i < claimed; ++i) {
+			SCell& cell = m_Cells[(pos + i) & m_Mask];
+			::new (static_cast<void*>(cell.storage)) TType(std::move(objs[i]));
+			cell.sequence.store(pos + i + 1, std::memory_order_release);
+		}
+		return claimed;
+	}
+
+	// Moves up to count elements out into objs with a single claim, returning how many were popped
+	size_t tryPopRange(TType* objs, const size_t count) {
+		static_assert(std::is_nothrow_move_assignable_v<TType>, "tryPopRange requires a type that can be move assigned without throwing");
+
+		size_t pos;
+		const size_t claimed = claim(m_DequeuePos, 1, count, pos);
+		for (size_t i = 0; i < claimed; ++i) {
+			SCell& cell = m_Cells[(pos + i) & m_Mask];
+			objs[i] = std::move(*cell.get());
+			std::destroy_at(cell.get());
+			cell.sequence.store(pos + i + getCapacity(), std::memory_order_release);
+		}
+		return claimed;
+	}
+
+private:
+
+	static size_t roundCapacity(const size_t capacity) {
+		size_t rounded = 2;
+		while (rounded < capacity) rounded <<= 1;
+		return rounded;
+	}
+
+	// Claims up to count cells in a row from position, a cell being ready once its sequence is its position plus offset
+	// Pushing waits for offset 0, the sequence a cell is given once it has been popped, and popping for offset 1, given once it has been pushed
+	// Returns how many cells were claimed, with pos set to the first, or 0 if the first cell is not ready, meaning the queue is full or empty
+	size_t claim(std::atomic<size_t>& position, const size_t offset, const size_t count, size_t& pos) {
+		if (count == 0) return 0;
+
+		pos = position.load(std::memory_order_relaxed);
+		while (true) {
+			size_t ready = 0;
+			while (ready < count && m_Cells[(pos + ready) & m_Mask].sequence.load(std::memory_order_acquire) == pos + ready + offset) {
+				++ready;
+			}
+
+			if (ready == 0) {
+				// Behind the position means the cell is still waiting on the lap before, ahead of it means another thread got there first
+				const size_t sequence = m_Cells[pos & m_Mask].sequence.load(std::memory_order_acquire);
+				if (static_cast<std::ptrdiff_t>(sequence - (pos + offset)) < 0) return 0;
+				pos = position.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			// On failure pos is reloaded, and the cells are checked again from there
+			if (position.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+				return ready;
+			}
+		}
+	}
+
+	template <typename... TArgs>
+	bool emplaceInCell(TArgs&&... args) {
+		size_t pos;
+		if (claim(m_EnqueuePos, 0, 1, pos) == 0) return false;
+
+		SCell& cell = m_Cells[pos & m_Mask];
+		::new (static_cast<void*>(cell.storage)) TType(std::forward<TArgs>(args)...);
+		cell.sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	TType takeFromCell(const size_t pos) {
+		SCell& cell = m_Cells[pos & m_Mask];
+		TType obj(std::move(*cell.get()));
+		std::destroy_at(cell.get());
+		cell.sequence.store(pos + getCapacity(), std::memory_order_release);
+		return obj;
+	}
+
+	CellAllocator m_Allocator;
+
+	SCell* m_Cells = nullptr;
+
+	size_t m_Mask;
+
+	// Each on a cache line of its own, so producers and consumers don't keep taking the line from each other
+	alignas(sstl::CACHE_LINE_SIZE) std::atomic<size_t> m_EnqueuePos{0};
+
+	alignas(sstl::CACHE_LINE_SIZE) std::atomic<size_t> m_DequeuePos{0};
+};
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TConcurrentQueue = ::TConcurrentQueue<TType, std::pmr::polymorphic_allocator<TType>>;
+}
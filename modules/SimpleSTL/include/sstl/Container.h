@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <functional>
+#include <memory_resource>
 #include <stdexcept>
 
 #include "sutil/Comparison.h"
@@ -34,6 +35,14 @@
 #define GUARANTEED = 0;
 #define NOT_GUARANTEED { throw std::runtime_error("Attempted Usage of unimplemented function in TContainer."); }
 
+// Marks the overrides used in tight loops as final, so calls through the concrete type can be inlined rather than going through the vtable
+// Opt in, as nothing can override these functions once enabled
+#ifdef SIMPLESTL_STATIC_DISPATCH
+#define STATIC_DISPATCH final
+#else
+#define STATIC_DISPATCH
+#endif
+
 // A basic container of any amount of objects
 // A size of 0 implies a dynamic array
 template <typename TType>
@@ -176,6 +185,31 @@ struct TSequenceContainer {
 		}
 	}
 
+	// Takes any callable rather than a std::function, so the call can be inlined
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) {
+		func(get(index));
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) const {
+		func(get(index));
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, get(i));
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, get(i));
+		}
+	}
+
 	// Iterates through each element
 	virtual void forEach(const std::function<void(size_t, TType&)>& func)
 		GUARANTEED
@@ -242,6 +276,20 @@ struct TAssociativeContainer {
 	virtual void reserve(size_t amt)
 		NOT_GUARANTEED
 
+	// Moves count pairs into the container in one pass, rather than growing it for each one
+	// Sorted containers sort the pairs by key in place first, unless isSorted says they already are
+	virtual void pushRange(TPair<TKeyType, TValueType>* pairs, const size_t count, const bool /*isSorted*/ = false) {
+		for (size_t i = 0; i < count; ++i) {
+			push(std::move(pairs[i]));
+		}
+	}
+
+	// Replaces everything in the container with count pairs
+	void build(TPair<TKeyType, TValueType>* pairs, const size_t count, const bool isSorted = false) {
+		clear();
+		pushRange(pairs, count, isSorted);
+	}
+
 	// Adds a defaulted element to the container
 	virtual TPair<TKeyType, const TValueType&> push()
 		GUARANTEED
@@ -333,6 +381,20 @@ struct TSingleAssociativeContainer {
 	virtual void reserve(size_t amt)
 		NOT_GUARANTEED
 
+	// Moves count elements into the container in one pass, rather than growing it for each one
+	// Sorted containers sort the elements in place first, unless isSorted says they already are
+	virtual void pushRange(TType* objs, const size_t count, const bool /*isSorted*/ = false) {
+		for (size_t i = 0; i < count; ++i) {
+			push(std::move(objs[i]));
+		}
+	}
+
+	// Replaces everything in the container with count elements
+	void build(TType* objs, const size_t count, const bool isSorted = false) {
+		clear();
+		pushRange(objs, count, isSorted);
+	}
+
 	// Adds a defaulted element to the container
 	virtual const TType& push()
 		GUARANTEED
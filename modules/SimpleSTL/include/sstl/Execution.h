@@ -0,0 +1,244 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Execution policies for the bulk container operations, mirroring std::execution
+ * Kept separate from <execution>, as some standard libraries need an extra library to use it
+ */
+
+namespace sstl::execution {
+	// Below this many elements a chunk isn't worth handing to another thread, unless each element is expensive
+	inline constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
+	struct sequenced_policy {};
+
+	struct parallel_policy {
+		size_t minChunkSize = DEFAULT_CHUNK_SIZE;
+
+		// Lets a func that is slow for every element run in parallel over a small container, par.chunked(1) splits down to single elements
+		[[nodiscard]] constexpr parallel_policy chunked(const size_t size) const { return parallel_policy{std::max<size_t>(size, 1)}; }
+	};
+
+	// Runs exactly as par does, the calls are not vectorized, it only exists so code written against std::execution still compiles
+	struct parallel_unsequenced_policy {
+		size_t minChunkSize = DEFAULT_CHUNK_SIZE;
+
+		[[nodiscard]] constexpr parallel_unsequenced_policy chunked(const size_t size) const { return parallel_unsequenced_policy{std::max<size_t>(size, 1)}; }
+	};
+
+	inline constexpr sequenced_policy seq{};
+	inline constexpr parallel_policy par{};
+	inline constexpr parallel_unsequenced_policy par_unseq{};
+
+	template <typename TType>
+	struct is_execution_policy : std::false_type {};
+
+	template <>
+	struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+	template <>
+	struct is_execution_policy<parallel_policy> : std::true_type {};
+
+	template <>
+	struct is_execution_policy<parallel_unsequenced_policy> : std::true_type {};
+
+	template <typename TType>
+	constexpr bool is_execution_policy_v = is_execution_policy<std::decay_t<TType>>::value;
+
+	template <typename TType>
+	constexpr bool is_parallel_policy_v = is_execution_policy_v<TType> && !std::is_same_v<std::decay_t<TType>, sequenced_policy>;
+}
+
+// A fixed set of workers that split a range of indices between them
+// The thread that starts the work takes chunks as well, so a parallel call made from inside another one can never deadlock
+class CThreadPool {
+
+	struct SJob {
+		// The caller waits for every chunk, so the callable can stay on its stack rather than being copied into a std::function
+		void (*invoke)(const void* func, size_t begin, size_t end) = nullptr;
+		const void* func = nullptr;
+		size_t count = 0;
+		size_t chunkSize = 0;
+		size_t chunkCount = 0;
+
+		std::atomic<size_t> nextChunk{0};
+		std::atomic<size_t> finishedChunks{0};
+
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::exception_ptr exception;
+	};
+
+public:
+
+	explicit CThreadPool(const size_t threadCount = std::thread::hardware_concurrency()) {
+		// The calling thread is also a worker
+		for (size_t i = 1; i < std::max<size_t>(threadCount, 1); ++i) {
+			m_Workers.emplace_back([this] { work(); });
+		}
+	}
+
+	CThreadPool(const CThreadPool&) = delete;
+	CThreadPool& operator=(const CThreadPool&) = delete;
+
+	~CThreadPool() {
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_Condition.notify_all();
+		for (auto& worker : m_Workers) {
+			worker.join();
+		}
+	}
+
+	// Shared by every container, created the first time it is used
+	static CThreadPool& get() {
+		static CThreadPool pool;
+		return pool;
+	}
+
+	[[nodiscard]] size_t getThreadCount() const {
+		return m_Workers.size() + 1;
+	}
+
+	// Calls func(begin, end) over [0, count) split into contiguous chunks, returning once every chunk has finished
+	// Chunks depend only on count and the thread count, every index is visited exactly once
+	// If func throws, the remaining chunks are skipped and the first exception is rethrown here
+	template <typename TFunc>
+	void parallelFor(const size_t count, const TFunc& func, const size_t minChunkSize = sstl::execution::DEFAULT_CHUNK_SIZE) {
+		if (count == 0) return;
+
+		// A few chunks per thread, so a slow chunk does not hold up everything else
+		const size_t chunkSize = std::max(minChunkSize, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+		if (m_Workers.empty() || chunkSize >= count) {
+			func(0, count);
+			return;
+		}
+
+		const auto job = std::make_shared<SJob>();
+		job->invoke = [](const void* inFunc, const size_t begin, const size_t end) { (*static_cast<const TFunc*>(inFunc))(begin, end); };
+		job->func = &func;
+		job->count = count;
+		job->chunkSize = chunkSize;
+		job->chunkCount = (count + chunkSize - 1) / chunkSize;
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Jobs.push_back(job);
+		}
+		m_Condition.notify_all();
+
+		run(*job);
+
+		{
+			std::unique_lock lock(job->mutex);
+			job->finished.wait(lock, [&] { return job->finishedChunks.load() == job->chunkCount; });
+		}
+
+		{
+			std::lock_guard lock(m_Mutex);
+			const auto itr = std::find(m_Jobs.begin(), m_Jobs.end(), job);
+			if (itr != m_Jobs.end()) m_Jobs.erase(itr);
+		}
+
+		if (job->exception) {
+			std::rethrow_exception(job->exception);
+		}
+	}
+
+private:
+
+	// Takes chunks of the job until there are none left
+	static void run(SJob& job) {
+		for (size_t chunk = job.nextChunk.fetch_add(1); chunk < job.chunkCount; chunk = job.nextChunk.fetch_add(1)) {
+			bool skip;
+			{
+				std::lock_guard lock(job.mutex);
+				skip = job.exception != nullptr;
+			}
+
+			if (!skip) {
+				const size_t begin = chunk * job.chunkSize;
+				try {
+					job.invoke(job.func, begin, std::min(begin + job.chunkSize, job.count));
+				} catch (...) {
+					std::lock_guard lock(job.mutex);
+					if (!job.exception) job.exception = std::current_exception();
+				}
+			}
+
+			if (job.finishedChunks.fetch_add(1) + 1 == job.chunkCount) {
+				// Taking the lock ensures the caller is either waiting or will see the count
+				{ std::lock_guard lock(job.mutex); }
+				job.finished.notify_all();
+			}
+		}
+	}
+
+	void work() {
+		while (true) {
+			std::shared_ptr<SJob> job;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_Condition.wait(lock, [&] { return m_Stopping || !m_Jobs.empty(); });
+				if (m_Stopping) return;
+
+				job = m_Jobs.front();
+				// Every chunk has been taken, so no one else needs to see it
+				if (job->nextChunk.load() >= job->chunkCount) {
+					m_Jobs.pop_front();
+					continue;
+				}
+			}
+			run(*job);
+		}
+	}
+
+	std::vector<std::thread> m_Workers;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::deque<std::shared_ptr<SJob>> m_Jobs;
+	bool m_Stopping = false;
+};
+
+namespace sstl::execution {
+	// Calls func(begin, end) over [0, count), either all at once or split between the threads of the shared pool
+	template <typename TPolicy, typename TFunc>
+	void forChunks(TPolicy&& policy, const size_t count, TFunc&& func) {
+		static_assert(is_execution_policy_v<TPolicy>, "TPolicy is not an execution policy!");
+		if constexpr (is_parallel_policy_v<TPolicy>) {
+			CThreadPool::get().parallelFor(count, func, policy.minChunkSize);
+		} else if (count > 0) {
+			func(static_cast<size_t>(0), count);
+		}
+	}
+
+	// The lowest index for which func(i) is true, or count if there is none
+	// Chunks that start after an index that has already been found are skipped
+	template <typename TPolicy, typename TFunc>
+	size_t findFirst(TPolicy&& policy, const size_t count, TFunc&& func) {
+		std::atomic<size_t> found{count};
+		forChunks(policy, count, [&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end && i < found.load(std::memory_order_relaxed); ++i) {
+				if (func(i)) {
+					size_t current = found.load();
+					while (i < current && !found.compare_exchange_weak(current, i)) {}
+					return;
+				}
+			}
+		});
+		return found.load();
+	}
+}
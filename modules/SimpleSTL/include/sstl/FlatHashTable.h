@@ -0,0 +1,490 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "sutil/Hashing.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMPLESTL_FLAT_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace sstl {
+
+	// The control bytes of 16 neighbouring slots, which are always probed together
+	// A full slot stores the low 7 bits of its hash, so most keys that don't match are ruled out without touching the slot itself
+	struct SControlGroup {
+
+		static constexpr size_t WIDTH = 16;
+
+		// Both have the high bit set, which full slots never do
+		static constexpr int8_t EMPTY = -128;
+		static constexpr int8_t DELETED = -2;
+
+		explicit SControlGroup(const int8_t* control) {
+#ifdef SIMPLESTL_FLAT_SSE2
+			m_Control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+			std::memcpy(m_Control, control, WIDTH);
+#endif
+		}
+
+		// One bit for each slot whose control byte is value
+		[[nodiscard]] uint32_t match(const int8_t value) const {
+#ifdef SIMPLESTL_FLAT_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), m_Control)));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < WIDTH; ++i) {
+				mask |= static_cast<uint32_t>(m_Control[i] == value) << i;
+			}
+			return mask;
+#endif
+		}
+
+		[[nodiscard]] uint32_t matchEmpty() const {
+			return match(EMPTY);
+		}
+
+		// Empty or deleted slots, either of which can take a new element
+		[[nodiscard]] uint32_t matchFree() const {
+#ifdef SIMPLESTL_FLAT_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(m_Control));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < WIDTH; ++i) {
+				mask |= static_cast<uint32_t>(m_Control[i] < 0) << i;
+			}
+			return mask;
+#endif
+		}
+
+		// The index of the lowest set bit, mask must not be empty
+		static size_t lowest(const uint32_t mask) {
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return index;
+#else
+			return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+		}
+
+	private:
+
+#ifdef SIMPLESTL_FLAT_SSE2
+		__m128i m_Control;
+#else
+		int8_t m_Control[WIDTH];
+#endif
+	};
+
+	// An open addressing hash table in the style of a swiss table, the storage behind TFlatSet and TFlatMap
+	// Slots are kept in one array and their control bytes in another, so a lookup is a group match and usually a single comparison
+	// TGetKey::get returns the key of a slot
+	template <typename TSlot, typename TKeyType, typename TGetKey, typename TAllocator>
+	class TFlatHashTable {
+
+		using SlotAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<TSlot>;
+		using SlotTraits = std::allocator_traits<SlotAllocator>;
+		using ControlAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<int8_t>;
+		using ControlTraits = std::allocator_traits<ControlAllocator>;
+
+	public:
+
+		template <bool TConst>
+		struct TIterator {
+
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = TSlot;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<TConst, const TSlot*, TSlot*>;
+			using reference = std::conditional_t<TConst, const TSlot&, TSlot&>;
+
+			TIterator() = default;
+
+			TIterator(const int8_t* control, const int8_t* end, pointer slot): m_Control(control), m_End(end), m_Slot(slot) {
+				skipFree();
+			}
+
+			operator TIterator<true>() const {
+				return TIterator<true>(m_Control, m_End, m_Slot);
+			}
+
+			reference operator*() const { return *m_Slot; }
+			pointer operator->() const { return m_Slot; }
+
+			TIterator& operator++() {
+				++m_Control;
+				++m_Slot;
+				skipFree();
+				return *this;
+			}
+
+			TIterator operator++(int) {
+				TIterator copy = *this;
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const TIterator& fst, const TIterator& snd) { return fst.m_Slot == snd.m_Slot; }
+			friend bool operator!=(const TIterator& fst, const TIterator& snd) { return fst.m_Slot != snd.m_Slot; }
+
+		private:
+
+			friend TFlatHashTable;
+
+			void skipFree() {
+				while (m_Control != m_End && *m_Control < 0) {
+					++m_Control;
+					++m_Slot;
+				}
+			}
+
+			const int8_t* m_Control = nullptr;
+			const int8_t* m_End = nullptr;
+			pointer m_Slot = nullptr;
+		};
+
+		using value_type = TSlot;
+		using allocator_type = TAllocator;
+		using iterator = TIterator<false>;
+		using const_iterator = TIterator<true>;
+
+		TFlatHashTable() = default;
+
+		explicit TFlatHashTable(const TAllocator& allocator): m_Allocator(allocator) {}
+
+		TFlatHashTable(const TFlatHashTable& otr): m_Allocator(SlotTraits::select_on_container_copy_construction(otr.m_Allocator)) {
+			copyFrom(otr);
+		}
+
+		TFlatHashTable(TFlatHashTable&& otr) noexcept: m_Allocator(std::move(otr.m_Allocator)) {
+			steal(otr);
+		}
+
+		TFlatHashTable& operator=(const TFlatHashTable& otr) {
+			if (this == &otr) return *this;
+			clear();
+			reserve(otr.m_Size);
+			for (const TSlot& slot : otr) {
+				insert(slot);
+			}
+			return *this;
+		}
+
+		// Memory can only be taken from otr if it can be freed by this table's allocator
+		TFlatHashTable& operator=(TFlatHashTable&& otr) noexcept(SlotTraits::propagate_on_container_move_assignment::value || SlotTraits::is_always_equal::value) {
+			if (this == &otr) return *this;
+			if constexpr (SlotTraits::propagate_on_container_move_assignment::value || SlotTraits::is_always_equal::value) {
+				clear();
+				deallocate(m_Control, m_Slots, m_Capacity);
+				if constexpr (SlotTraits::propagate_on_container_move_assignment::value) {
+					m_Allocator = std::move(otr.m_Allocator);
+				}
+				steal(otr);
+			} else if (m_Allocator == otr.m_Allocator) {
+				clear();
+				deallocate(m_Control, m_Slots, m_Capacity);
+				steal(otr);
+			} else {
+				clear();
+				reserve(otr.m_Size);
+				for (TSlot& slot : otr) {
+					insert(std::move(slot));
+				}
+				otr.clear();
+			}
+			return *this;
+		}
+
+		~TFlatHashTable() {
+			clear();
+			deallocate(m_Control, m_Slots, m_Capacity);
+		}
+
+		[[nodiscard]] size_t size() const { return m_Size; }
+
+		[[nodiscard]] bool empty() const { return m_Size == 0; }
+
+		// The number of slots, of which at most 7 in 8 are filled before the table grows
+		[[nodiscard]] size_t capacity() const { return m_Capacity; }
+
+		[[nodiscard]] TAllocator get_allocator() const { return TAllocator(m_Allocator); }
+
+		iterator begin() { return iterator(m_Control, m_Control + m_Capacity, m_Slots); }
+		const_iterator begin() const { return const_iterator(m_Control, m_Control + m_Capacity, m_Slots); }
+		const_iterator cbegin() const { return begin(); }
+
+		iterator end() { return iterator(m_Control + m_Capacity, m_Control + m_Capacity, m_Slots + m_Capacity); }
+		const_iterator end() const { return const_iterator(m_Control + m_Capacity, m_Control + m_Capacity, m_Slots + m_Capacity); }
+		const_iterator cend() const { return end(); }
+
+		// The full slot furthest into the table, the table must not be empty
+		const TSlot& back() const {
+			size_t index = m_Capacity;
+			while (m_Control[--index] < 0) {}
+			return m_Slots[index];
+		}
+
+		iterator find(const TKeyType& key) {
+			const size_t index = findIndex(key, hashOf(key));
+			return iterator(m_Control + index, m_Control + m_Capacity, m_Slots + index);
+		}
+
+		const_iterator find(const TKeyType& key) const {
+			const size_t index = findIndex(key, hashOf(key));
+			return const_iterator(m_Control + index, m_Control + m_Capacity, m_Slots + index);
+		}
+
+		[[nodiscard]] bool contains(const TKeyType& key) const {
+			return findIndex(key, hashOf(key)) != m_Capacity;
+		}
+
+		// Builds a slot from args only if key isn't in the table yet
+		// key is only used for the lookup, so it may refer to one of args
+		template <typename... TArgs>
+		std::pair<iterator, bool> tryEmplace(const TKeyType& key, TArgs&&... args) {
+			const size_t hash = hashOf(key);
+			size_t index = findIndex(key, hash);
+			if (index != m_Capacity) {
+				return {iterator(m_Control + index, m_Control + m_Capacity, m_Slots + index), false};
+			}
+
+			if (m_GrowthLeft == 0) {
+				// When most of what is used is deleted slots, clearing them out is enough
+				rehash(m_Size * 2 <= getMaxLoad(m_Capacity) && m_Capacity > 0 ? m_Capacity : std::max(m_Capacity * 2, SControlGroup::WIDTH));
+			}
+
+			index = findFree(hash);
+			SlotTraits::construct(m_Allocator, m_Slots + index, std::forward<TArgs>(args)...);
+			// Taking a deleted slot doesn't use up any of the growth left
+			if (m_Control[index] == SControlGroup::EMPTY) {
+				--m_GrowthLeft;
+			}
+			m_Control[index] = getControl(hash);
+			++m_Size;
+			return {iterator(m_Control + index, m_Control + m_Capacity, m_Slots + index), true};
+		}
+
+		std::pair<iterator, bool> insert(const TSlot& slot) {
+			return tryEmplace(TGetKey::get(slot), slot);
+		}
+
+		std::pair<iterator, bool> insert(TSlot&& slot) {
+			return tryEmplace(TGetKey::get(slot), std::move(slot));
+		}
+
+		template <typename... TArgs>
+		std::pair<iterator, bool> emplace(TArgs&&... args) {
+			TSlot slot(std::forward<TArgs>(args)...);
+			return insert(std::move(slot));
+		}
+
+		size_t erase(const TKeyType& key) {
+			const size_t index = findIndex(key, hashOf(key));
+			if (index == m_Capacity) return 0;
+			eraseAt(index);
+			return 1;
+		}
+
+		iterator erase(const_iterator position) {
+			const size_t index = position.m_Slot - m_Slots;
+			eraseAt(index);
+			return iterator(m_Control + index + 1, m_Control + m_Capacity, m_Slots + index + 1);
+		}
+
+		// Makes room for amt elements without growing again
+		void reserve(const size_t amt) {
+			size_t capacity = m_Capacity > 0 ? m_Capacity : SControlGroup::WIDTH;
+			while (getMaxLoad(capacity) < amt) {
+				capacity *= 2;
+			}
+			if (capacity > m_Capacity) {
+				rehash(capacity);
+			}
+		}
+
+		// Keeps the slots, so the table can be filled again without allocating
+		void clear() {
+			if constexpr (!std::is_trivially_destructible_v<TSlot>) {
+				for (size_t i = 0; i < m_Capacity && m_Size > 0; ++i) {
+					if (m_Control[i] >= 0) {
+						SlotTraits::destroy(m_Allocator, m_Slots + i);
+						--m_Size;
+					}
+				}
+			}
+			if (m_Capacity > 0) {
+				std::memset(m_Control, SControlGroup::EMPTY, m_Capacity);
+			}
+			m_Size = 0;
+			m_GrowthLeft = getMaxLoad(m_Capacity);
+		}
+
+	private:
+
+		static size_t hashOf(const TKeyType& key) {
+			return shash::distribute(getHash(key));
+		}
+
+		static int8_t getControl(const size_t hash) {
+			return static_cast<int8_t>(hash & 0x7F);
+		}
+
+		static size_t getMaxLoad(const size_t capacity) {
+			return capacity - capacity / 8;
+		}
+
+		// Groups are probed in triangular steps, which visit each group once since the group count is a power of two
+		// Returns m_Capacity if the key isn't found
+		size_t findIndex(const TKeyType& key, const size_t hash) const {
+			if (m_Size == 0) return m_Capacity;
+			const size_t groupMask = m_Capacity / SControlGroup::WIDTH - 1;
+			const int8_t control = getControl(hash);
+			size_t group = (hash >> 7) & groupMask;
+			for (size_t step = 1;; ++step) {
+				const size_t offset = group * SControlGroup::WIDTH;
+				const SControlGroup controls(m_Control + offset);
+				for (uint32_t mask = controls.match(control); mask != 0; mask &= mask - 1) {
+					const size_t index = offset + SControlGroup::lowest(mask);
+					if (TGetKey::get(m_Slots[index]) == key) return index;
+				}
+				// Anything inserted later in the probe would have taken this empty slot instead
+				if (controls.matchEmpty() != 0) return m_Capacity;
+				group = (group + step) & groupMask;
+			}
+		}
+
+		// There is always a free slot, since the table grows before running out of empty ones
+		size_t findFree(const size_t hash) const {
+			const size_t groupMask = m_Capacity / SControlGroup::WIDTH - 1;
+			size_t group = (hash >> 7) & groupMask;
+			for (size_t step = 1;; ++step) {
+				const size_t offset = group * SControlGroup::WIDTH;
+				if (const uint32_t mask = SControlGroup(m_Control + offset).matchFree()) {
+					return offset + SControlGroup::lowest(mask);
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		void eraseAt(const size_t index) {
+			SlotTraits::destroy(m_Allocator, m_Slots + index);
+			--m_Size;
+			// If the group still has an empty slot, no probe has ever gone past it, so this slot can be empty again
+			const size_t offset = index - index % SControlGroup::WIDTH;
+			if (SControlGroup(m_Control + offset).matchEmpty() != 0) {
+				m_Control[index] = SControlGroup::EMPTY;
+				++m_GrowthLeft;
+			} else {
+				m_Control[index] = SControlGroup::DELETED;
+			}
+		}
+
+		// Moves every element into a table of capacity slots, if an element throws the table is left as it was
+		void rehash(const size_t capacity) {
+			int8_t* oldControl = m_Control;
+			TSlot* oldSlots = m_Slots;
+			const size_t oldCapacity = m_Capacity;
+
+			allocate(capacity);
+
+			try {
+				for (size_t i = 0; i < oldCapacity; ++i) {
+					if (oldControl[i] < 0) continue;
+					const size_t hash = hashOf(TGetKey::get(oldSlots[i]));
+					const size_t index = findFree(hash);
+					SlotTraits::construct(m_Allocator, m_Slots + index, std::move_if_noexcept(oldSlots[i]));
+					m_Control[index] = getControl(hash);
+				}
+			} catch (...) {
+				for (size_t i = 0; i < m_Capacity; ++i) {
+					if (m_Control[i] >= 0) SlotTraits::destroy(m_Allocator, m_Slots + i);
+				}
+				deallocate(m_Control, m_Slots, m_Capacity);
+				m_Control = oldControl;
+				m_Slots = oldSlots;
+				m_Capacity = oldCapacity;
+				throw;
+			}
+
+			for (size_t i = 0; i < oldCapacity; ++i) {
+				if (oldControl[i] >= 0) SlotTraits::destroy(m_Allocator, oldSlots + i);
+			}
+			deallocate(oldControl, oldSlots, oldCapacity);
+			m_GrowthLeft = getMaxLoad(m_Capacity) - m_Size;
+		}
+
+		void copyFrom(const TFlatHashTable& otr) {
+			if (otr.m_Size == 0) return;
+			allocate(otr.m_Capacity);
+			size_t i = 0;
+			try {
+				for (; i < m_Capacity; ++i) {
+					if (otr.m_Control[i] < 0) continue;
+					SlotTraits::construct(m_Allocator, m_Slots + i, otr.m_Slots[i]);
+				}
+			} catch (...) {
+				for (size_t j = 0; j < i; ++j) {
+					if (otr.m_Control[j] >= 0) SlotTraits::destroy(m_Allocator, m_Slots + j);
+				}
+				deallocate(m_Control, m_Slots, m_Capacity);
+				m_Control = nullptr;
+				m_Slots = nullptr;
+				m_Capacity = 0;
+				throw;
+			}
+			// Every slot stays where it was, deleted ones included, so probes still pass over the same slots
+			std::memcpy(m_Control, otr.m_Control, m_Capacity);
+			m_Size = otr.m_Size;
+			m_GrowthLeft = otr.m_GrowthLeft;
+		}
+
+		void steal(TFlatHashTable& otr) {
+			m_Control = std::exchange(otr.m_Control, nullptr);
+			m_Slots = std::exchange(otr.m_Slots, nullptr);
+			m_Capacity = std::exchange(otr.m_Capacity, 0);
+			m_Size = std::exchange(otr.m_Size, 0);
+			m_GrowthLeft = std::exchange(otr.m_GrowthLeft, 0);
+		}
+
+		// Replaces the arrays with empty ones of capacity slots, the old arrays are left to the caller
+		void allocate(const size_t capacity) {
+			ControlAllocator controlAllocator(m_Allocator);
+			int8_t* control = ControlTraits::allocate(controlAllocator, capacity);
+			try {
+				m_Slots = SlotTraits::allocate(m_Allocator, capacity);
+			} catch (...) {
+				ControlTraits::deallocate(controlAllocator, control, capacity);
+				throw;
+			}
+			m_Control = control;
+			m_Capacity = capacity;
+			std::memset(m_Control, SControlGroup::EMPTY, m_Capacity);
+		}
+
+		void deallocate(int8_t* control, TSlot* slots, const size_t capacity) {
+			if (capacity == 0) return;
+			ControlAllocator controlAllocator(m_Allocator);
+			ControlTraits::deallocate(controlAllocator, control, capacity);
+			SlotTraits::deallocate(m_Allocator, slots, capacity);
+		}
+
+		int8_t* m_Control = nullptr;
+		TSlot* m_Slots = nullptr;
+		size_t m_Capacity = 0;
+		size_t m_Size = 0;
+		// How many more empty slots can be filled before the table has to grow
+		size_t m_GrowthLeft = 0;
+		SlotAllocator m_Allocator;
+	};
+}
@@ -0,0 +1,246 @@
+﻿#pragma once
+
+#include <functional>
+#include "Container.h"
+#include "FlatHashTable.h"
+#include "sutil/InitializerList.h"
+#include "sutil/Hashing.h"
+
+// A map kept in one flat array rather than in separately allocated nodes, a drop in replacement for TMap
+// Values move when the map grows or is rehashed, so references to them only last until the next push
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<TKeyType, TValueType>>,
+	std::enable_if_t<sutil::is_hashable_v<TKeyType>, int> = 0
+>
+struct TFlatMap : TAssociativeContainer<TKeyType, TValueType> {
+
+	TFlatMap() = default;
+
+	template <typename TOtherValueType = TValueType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherValueType>, int> = 0
+	>
+	TFlatMap(TInitializerList<TPair<TKeyType, TValueType>> init) {
+		m_Container.reserve(init.size());
+		for (auto& pair : init) {
+			m_Container.tryEmplace(pair.first, pair.first, pair.second);
+		}
+	}
+
+	// Kept from taking an allocator, which goes to the constructor below, or another map, which is copied
+	template <typename... TPairs,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_convertible<TPairs, TAllocator>>..., std::negation<std::is_same<std::decay_t<TPairs>, TFlatMap>>...>, int> = 0
+	>
+	explicit TFlatMap(TPairs&&... args) {
+		m_Container.reserve(sizeof...(TPairs));
+		(m_Container.tryEmplace(args.first, std::forward<typename TPairs::KeyType>(args.first), std::forward<typename TPairs::ValueType>(args.second)), ...);
+	}
+
+	explicit TFlatMap(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
+
+	// The number of slots, which is what the map takes in memory along with a control byte for each
+	[[nodiscard]] size_t getCapacity() const { return m_Container.capacity(); }
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Container.size();
+	}
+
+	virtual TPair<TKeyType, const TValueType&> top() const override {
+		auto itr = m_Container.begin();
+		return TPair<TKeyType, const TValueType&>{itr->first, itr->second};
+	}
+
+	virtual TPair<TKeyType, const TValueType&> bottom() const override {
+		const auto& pair = m_Container.back();
+		return TPair<TKeyType, const TValueType&>{pair.first, pair.second};
+	}
+
+	virtual bool contains(const TKeyType& key) const override {
+		return m_Container.contains(key);
+	}
+
+	virtual TValueType& get(const TKeyType& key) override {
+		auto itr = m_Container.find(key);
+		if (itr == m_Container.end()) {
+			throw std::runtime_error("Key is not in the map!");
+		}
+		return itr->second;
+	}
+
+	virtual const TValueType& get(const TKeyType& key) const override {
+		auto itr = m_Container.find(key);
+		if (itr == m_Container.end()) {
+			throw std::runtime_error("Key is not in the map!");
+		}
+		return itr->second;
+	}
+
+	virtual void resize(const size_t amt, std::function<TPair<TKeyType, TValueType>()> func) override {
+		m_Container.reserve(amt);
+		for (size_t i = getSize(); i < amt; ++i) {
+			TPair<TKeyType, TValueType> pair = func();
+			m_Container.tryEmplace(pair.first, std::move(pair.first), std::move(pair.second));
+		}
+	}
+
+	virtual void reserve(size_t amt) override {
+		m_Container.reserve(amt);
+	}
+
+	// Reserves once for every pair, so the table never rehashes partway through
+	virtual void pushRange(TPair<TKeyType, TValueType>* pairs, const size_t count, const bool = false) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			m_Container.reserve(getSize() + count);
+			for (size_t i = 0; i < count; ++i) {
+				m_Container.tryEmplace(pairs[i].first, std::move(pairs[i].first), std::move(pairs[i].second));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual TPair<TKeyType, const TValueType&> push() override {
+		if constexpr (std::is_default_constructible_v<TKeyType> && std::is_default_constructible_v<TValueType>) {
+			auto& pair = *m_Container.emplace().first;
+			return TPair<TKeyType, const TValueType&>{pair.first, pair.second};
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	// Unlike TMap, these look the key up once rather than again after pushing
+	virtual TValueType& push(const TKeyType& key) override {
+		if constexpr (std::is_default_constructible_v<TValueType>) {
+			return m_Container.tryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first->second;
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key, const TValueType& value) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			return m_Container.tryEmplace(key, key, value).first->second;
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key, TValueType&& value) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			return m_Container.tryEmplace(key, key, std::move(value)).first->second;
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void push(const TPair<TKeyType, TValueType>& pair) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			m_Container.tryEmplace(pair.first, pair.first, pair.second);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(TPair<TKeyType, TValueType>&& pair) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			m_Container.tryEmplace(pair.first, std::move(pair.first), std::move(pair.second));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void replace(const TKeyType& key, const TValueType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			pop(key);
+			push(TPair<TKeyType, TValueType>{key, obj});
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const TKeyType& key, TValueType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			pop(key);
+			push(TPair<TKeyType, TValueType>{key, std::move(obj)});
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Keeps the slots, so refilling the map doesn't allocate
+	virtual void clear() override {
+		m_Container.clear();
+	}
+
+	virtual void pop() override {
+		m_Container.erase(m_Container.begin());
+	}
+
+	virtual void pop(const TKeyType& key) override {
+		m_Container.erase(key);
+	}
+
+	// The pair is taken out before it is pushed, since otr may be this map
+	virtual void transfer(TAssociativeContainer<TKeyType, TValueType>& otr, const TKeyType& key) override {
+		auto itr = m_Container.find(key);
+		if (itr == m_Container.end()) return;
+		// Prefer move, but copy if not available
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			std::pair<TKeyType, TValueType> pair = std::move(*itr);
+			m_Container.erase(itr);
+			otr.push(pair.first, std::move(pair.second));
+		} else {
+			std::pair<TKeyType, TValueType> pair = *itr;
+			m_Container.erase(itr);
+			otr.push(pair.first, pair.second);
+		}
+	}
+
+	virtual void forEach(const std::function<void(TPair<TKeyType, const TValueType&>)>& func) const override {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+protected:
+
+	struct GetKey {
+		static const TKeyType& get(const std::pair<TKeyType, TValueType>& pair) { return pair.first; }
+	};
+
+	sstl::TFlatHashTable<std::pair<TKeyType, TValueType>, TKeyType, GetKey, TAllocator> m_Container;
+
+public:
+
+	// Keys are stored without const so pairs can be moved as the map grows, they must not be changed through an iterator
+	using value_type = typename decltype(m_Container)::value_type;
+	using iterator = typename decltype(m_Container)::iterator;
+	using const_iterator = typename decltype(m_Container)::const_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+};
+
+template <typename TKeyType, typename TValueType>
+TFlatMap(TInitializerList<TPair<TKeyType, TValueType>>) -> TFlatMap<TKeyType, TValueType>;
+
+template <typename TPair, typename... TPairs>
+TFlatMap(TPair, TPairs...) -> TFlatMap<typename TPair::KeyType, typename TPair::ValueType>;
+
+namespace sstl::pmr {
+	template <typename TKeyType, typename TValueType>
+	using TFlatMap = ::TFlatMap<TKeyType, TValueType, std::pmr::polymorphic_allocator<std::pair<TKeyType, TValueType>>>;
+}
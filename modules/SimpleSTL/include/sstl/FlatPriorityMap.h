@@ -0,0 +1,331 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "Container.h"
+#include "sutil/InitializerList.h"
+
+// A map kept sorted by key in one array and searched with a binary search, in place of TPriorityMap for data that is read far more than it is changed
+// Pushing or popping a single pair shifts everything after it, so filling it is best done in bulk with pushRange
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<TKeyType, TValueType>>,
+          std::enable_if_t<sutil::is_less_than_comparable_v<TKeyType>, int> = 0
+>
+struct TFlatPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
+
+	TFlatPriorityMap() = default;
+
+	template <typename TOtherValueType = TValueType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherValueType>, int> = 0
+	>
+	TFlatPriorityMap(TInitializerList<TPair<TKeyType, TValueType>> init) {
+		m_Container.reserve(init.size());
+		for (auto& pair : init) {
+			m_Container.emplace_back(pair.first, pair.second);
+		}
+		sortFrom(0);
+	}
+
+	// Kept from taking an allocator or a vector, which go to the constructors below, or another map, which is copied
+	template <typename... TPairs,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_convertible<TPairs, TAllocator>>..., std::negation<std::is_convertible<TPairs, std::vector<std::pair<TKeyType, TValueType>, TAllocator>>>..., std::negation<std::is_same<std::decay_t<TPairs>, TFlatPriorityMap>>...>, int> = 0
+	>
+	explicit TFlatPriorityMap(TPairs&&... args) {
+		m_Container.reserve(sizeof...(TPairs));
+		(m_Container.emplace_back(std::forward<typename TPairs::KeyType>(args.first), std::forward<typename TPairs::ValueType>(args.second)), ...);
+		sortFrom(0);
+	}
+
+	// Takes the pairs in any order, and sorts them once
+	explicit TFlatPriorityMap(std::vector<std::pair<TKeyType, TValueType>, TAllocator> pairs): m_Container(std::move(pairs)) {
+		sortFrom(0);
+	}
+
+	explicit TFlatPriorityMap(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Container.size();
+	}
+
+	virtual TPair<TKeyType, const TValueType&> top() const override {
+		return TPair<TKeyType, const TValueType&>{m_Container.front().first, m_Container.front().second};
+	}
+
+	virtual TPair<TKeyType, const TValueType&> bottom() const override {
+		return TPair<TKeyType, const TValueType&>{m_Container.back().first, m_Container.back().second};
+	}
+
+	virtual bool contains(const TKeyType& key) const override {
+		return find(key) != m_Container.end();
+	}
+
+	virtual TValueType& get(const TKeyType& key) override {
+		auto itr = find(key);
+		if (itr == m_Container.end()) {
+			throw std::runtime_error("Key is not in the map!");
+		}
+		return itr->second;
+	}
+
+	virtual const TValueType& get(const TKeyType& key) const override {
+		auto itr = find(key);
+		if (itr == m_Container.end()) {
+			throw std::runtime_error("Key is not in the map!");
+		}
+		return itr->second;
+	}
+
+	virtual void resize(const size_t amt, std::function<TPair<TKeyType, TValueType>()> func) override {
+		const size_t size = getSize();
+		m_Container.reserve(amt);
+		for (size_t i = size; i < amt; ++i) {
+			TPair<TKeyType, TValueType> pair = func();
+			m_Container.emplace_back(std::move(pair.first), std::move(pair.second));
+		}
+		sortFrom(size);
+	}
+
+	virtual void reserve(size_t amt) override {
+		m_Container.reserve(amt);
+	}
+
+	virtual TPair<TKeyType, const TValueType&> push() override {
+		if constexpr (std::is_default_constructible_v<TKeyType> && std::is_default_constructible_v<TValueType>) {
+			auto& pair = *insert(TKeyType{});
+			return TPair<TKeyType, const TValueType&>{pair.first, pair.second};
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key) override {
+		if constexpr (std::is_default_constructible_v<TValueType>) {
+			return insert(key)->second;
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key, const TValueType& value) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			return insert(key, value)->second;
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key, TValueType&& value) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			return insert(key, std::move(value))->second;
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void push(const TPair<TKeyType, TValueType>& pair) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			insert(pair.first, pair.second);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(TPair<TKeyType, TValueType>&& pair) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			insert(std::move(pair.first), std::move(pair.second));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Appends the pairs and sorts them in all at once, rather than shifting the array for each one
+	// Keys already in the map keep their values over equal keys in the range
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		const size_t size = getSize();
+		for (; first != last; ++first) {
+			m_Container.emplace_back(first->first, first->second);
+		}
+		sortFrom(size);
+	}
+
+	virtual void pushRange(TPair<TKeyType, TValueType>* pairs, const size_t count, const bool isSorted = false) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			const size_t size = getSize();
+			m_Container.reserve(size + count);
+			for (size_t i = 0; i < count; ++i) {
+				m_Container.emplace_back(std::move(pairs[i].first), std::move(pairs[i].second));
+			}
+			sortFrom(size, isSorted);
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void replace(const TKeyType& key, const TValueType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			pop(key);
+			push(TPair<TKeyType, TValueType>{key, obj});
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const TKeyType& key, TValueType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			pop(key);
+			push(TPair<TKeyType, TValueType>{key, std::move(obj)});
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void clear() override {
+		m_Container.clear();
+	}
+
+	virtual void pop() override {
+		m_Container.erase(m_Container.begin());
+	}
+
+	virtual void pop(const TKeyType& key) override {
+		auto itr = find(key);
+		if (itr != m_Container.end()) {
+			m_Container.erase(itr);
+		}
+	}
+
+	// The pair is taken out before it is pushed, since otr may be this map
+	virtual void transfer(TAssociativeContainer<TKeyType, TValueType>& otr, const TKeyType& key) override {
+		auto itr = find(key);
+		if (itr == m_Container.end()) return;
+		// Prefer move, but copy if not available
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			std::pair<TKeyType, TValueType> pair = std::move(*itr);
+			m_Container.erase(itr);
+			otr.push(pair.first, std::move(pair.second));
+		} else {
+			std::pair<TKeyType, TValueType> pair = *itr;
+			m_Container.erase(itr);
+			otr.push(pair.first, pair.second);
+		}
+	}
+
+	virtual void forEach(const std::function<void(TPair<TKeyType, const TValueType&>)>& func) const override {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// Range queries, which are a pair of binary searches followed by a walk over contiguous pairs
+
+	// The first pair whose key is not less than key
+	auto lowerBound(const TKeyType& key) const {
+		return std::lower_bound(m_Container.begin(), m_Container.end(), key, KeyLess{});
+	}
+
+	// The first pair whose key is greater than key
+	auto upperBound(const TKeyType& key) const {
+		return std::upper_bound(m_Container.begin(), m_Container.end(), key, KeyLess{});
+	}
+
+	// Calls func on every pair with a key from min up to, but not including, max
+	template <typename TFunc>
+	void forRange(const TKeyType& min, const TKeyType& max, TFunc&& func) const {
+		for (auto itr = lowerBound(min); itr != m_Container.end() && itr->first < max; ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// The number of pairs with a key from min up to, but not including, max
+	[[nodiscard]] size_t countRange(const TKeyType& min, const TKeyType& max) const {
+		const auto first = lowerBound(min);
+		return static_cast<size_t>(std::lower_bound(first, m_Container.end(), max, KeyLess{}) - first);
+	}
+
+	// Keys are stored without const so pairs can be shifted along the array, they must not be changed through an iterator
+	using value_type = typename std::vector<std::pair<TKeyType, TValueType>, TAllocator>::value_type;
+	using iterator = typename std::vector<std::pair<TKeyType, TValueType>, TAllocator>::iterator;
+	using const_iterator = typename std::vector<std::pair<TKeyType, TValueType>, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::vector<std::pair<TKeyType, TValueType>, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::vector<std::pair<TKeyType, TValueType>, TAllocator>::const_reverse_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
+protected:
+
+	// Compares a pair to a key in either order, so it works with both lower_bound and upper_bound
+	struct KeyLess {
+		bool operator()(const std::pair<TKeyType, TValueType>& pair, const TKeyType& key) const { return pair.first < key; }
+		bool operator()(const TKeyType& key, const std::pair<TKeyType, TValueType>& pair) const { return key < pair.first; }
+	};
+
+	iterator find(const TKeyType& key) {
+		auto itr = std::lower_bound(m_Container.begin(), m_Container.end(), key, KeyLess{});
+		return itr != m_Container.end() && !(key < itr->first) ? itr : m_Container.end();
+	}
+
+	const_iterator find(const TKeyType& key) const {
+		auto itr = std::lower_bound(m_Container.begin(), m_Container.end(), key, KeyLess{});
+		return itr != m_Container.end() && !(key < itr->first) ? itr : m_Container.end();
+	}
+
+	// Builds the pair from key and args only if key isn't in the map yet
+	template <typename TOtherKeyType, typename... TArgs>
+	iterator insert(TOtherKeyType&& key, TArgs&&... args) {
+		auto itr = std::lower_bound(m_Container.begin(), m_Container.end(), key, KeyLess{});
+		if (itr != m_Container.end() && !(key < itr->first)) return itr;
+		return m_Container.emplace(itr, std::piecewise_construct, std::forward_as_tuple(std::forward<TOtherKeyType>(key)), std::forward_as_tuple(std::forward<TArgs>(args)...));
+	}
+
+	// Sorts the pairs from start on, unless isSorted says they already are, and merges them into the sorted ones before, dropping any with the same key as an earlier one
+	// Stable, so when keys are equal the pair that was already there wins
+	void sortFrom(const size_t start, const bool isSorted = false) {
+		const auto keyLess = [](const std::pair<TKeyType, TValueType>& fst, const std::pair<TKeyType, TValueType>& snd) {
+			return fst.first < snd.first;
+		};
+		const auto middle = m_Container.begin() + static_cast<std::ptrdiff_t>(start);
+		if (!isSorted) {
+			std::stable_sort(middle, m_Container.end(), keyLess);
+		}
+		std::inplace_merge(m_Container.begin(), middle, m_Container.end(), keyLess);
+		m_Container.erase(std::unique(m_Container.begin(), m_Container.end(), [](const std::pair<TKeyType, TValueType>& fst, const std::pair<TKeyType, TValueType>& snd) {
+			return !(fst.first < snd.first);
+		}), m_Container.end());
+	}
+
+	std::vector<std::pair<TKeyType, TValueType>, TAllocator> m_Container;
+};
+
+template <typename TKeyType, typename TValueType>
+TFlatPriorityMap(TInitializerList<TPair<TKeyType, TValueType>>) -> TFlatPriorityMap<TKeyType, TValueType>;
+
+template <typename TPair, typename... TPairs>
+TFlatPriorityMap(TPair, TPairs...) -> TFlatPriorityMap<typename TPair::KeyType, typename TPair::ValueType>;
+
+namespace sstl::pmr {
+	template <typename TKeyType, typename TValueType>
+	using TFlatPriorityMap = ::TFlatPriorityMap<TKeyType, TValueType, std::pmr::polymorphic_allocator<std::pair<TKeyType, TValueType>>>;
+}
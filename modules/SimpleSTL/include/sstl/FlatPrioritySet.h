@@ -0,0 +1,307 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "Container.h"
+#include "sutil/InitializerList.h"
+
+// A set kept sorted in one array and searched with a binary search, in place of TPrioritySet for data that is read far more than it is changed
+// Pushing or popping a single element shifts everything after it, so filling it is best done in bulk with pushRange
+template <typename TType, typename TAllocator = std::allocator<TType>,
+          std::enable_if_t<sutil::is_less_than_comparable_v<TType>, int> = 0
+>
+struct TFlatPrioritySet : TSingleAssociativeContainer<TType> {
+
+	TFlatPrioritySet() = default;
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TFlatPrioritySet(TInitializerList<TType> init) {
+		pushRange(init.begin(), init.end());
+	}
+
+	// Kept from taking an allocator, which goes to the constructor below
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
+	>
+	explicit TFlatPrioritySet(TArgs&&... args) {
+		m_Container.reserve(sizeof...(TArgs));
+		(m_Container.emplace_back(std::forward<TArgs>(args)), ...);
+		sortFrom(0);
+	}
+
+	// Takes the elements in any order, and sorts them once
+	explicit TFlatPrioritySet(std::vector<TType, TAllocator> elements): m_Container(std::move(elements)) {
+		sortFrom(0);
+	}
+
+	explicit TFlatPrioritySet(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Container.size();
+	}
+
+	virtual const TType& top() const override {
+		return m_Container.front();
+	}
+
+	virtual const TType& bottom() const override {
+		return m_Container.back();
+	}
+
+	virtual bool contains(const TType& obj) const override {
+		return std::binary_search(m_Container.begin(), m_Container.end(), obj);
+	}
+
+	virtual bool contains(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			return findPointer(obj) != m_Container.end();
+		} else {
+			return contains(*obj);
+		}
+	}
+
+	virtual void resize(const size_t amt) override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			for (size_t i = getSize(); i < amt; ++i) {
+				push();
+			}
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void resize(const size_t amt, std::function<TType()> func) override {
+		const size_t size = getSize();
+		m_Container.reserve(amt);
+		for (size_t i = size; i < amt; ++i) {
+			m_Container.push_back(func());
+		}
+		sortFrom(size);
+	}
+
+	virtual void reserve(const size_t amt) override {
+		m_Container.reserve(amt);
+	}
+
+	virtual const TType& push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			return *insert(TType{});
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void push(const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			insert(obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			insert(std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Appends the elements and sorts them in all at once, rather than shifting the array for each one
+	// Elements already in the set are kept over equal ones in the range
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		const size_t size = getSize();
+		m_Container.insert(m_Container.end(), first, last);
+		sortFrom(size);
+	}
+
+	virtual void pushRange(TType* objs, const size_t count, const bool isSorted = false) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			const size_t size = getSize();
+			m_Container.insert(m_Container.end(), std::make_move_iterator(objs), std::make_move_iterator(objs + count));
+			sortFrom(size, isSorted);
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void replace(const TType& tgt, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			pop(tgt);
+			insert(obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const TType& tgt, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			pop(tgt);
+			insert(std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void clear() override {
+		m_Container.clear();
+	}
+
+	virtual void pop() override {
+		m_Container.erase(m_Container.begin());
+	}
+
+	virtual void pop(const TType& obj) override {
+		auto itr = std::lower_bound(m_Container.begin(), m_Container.end(), obj);
+		if (itr != m_Container.end() && !(obj < *itr)) {
+			m_Container.erase(itr);
+		}
+	}
+
+	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			if (auto itr = findPointer(obj); itr != m_Container.end()) {
+				m_Container.erase(itr);
+			}
+		} else {
+			pop(*obj);
+		}
+	}
+
+	virtual void transfer(TSingleAssociativeContainer<TType>& otr, TType& obj) override {
+		auto itr = std::lower_bound(m_Container.begin(), m_Container.end(), obj);
+		if (itr == m_Container.end() || obj < *itr) return;
+		moveTo(otr, itr);
+	}
+
+	virtual void transfer(TSingleAssociativeContainer<TType>& otr, typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			auto itr = findPointer(obj);
+			if (itr == m_Container.end()) return;
+			moveTo(otr, itr);
+		} else {
+			transfer(otr, *obj);
+		}
+	}
+
+	virtual void forEach(const std::function<void(const TType&)>& func) const override {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	// Range queries, which are a pair of binary searches followed by a walk over contiguous elements
+
+	// The first element that is not less than obj
+	auto lowerBound(const TType& obj) const {
+		return std::lower_bound(m_Container.begin(), m_Container.end(), obj);
+	}
+
+	// The first element that is greater than obj
+	auto upperBound(const TType& obj) const {
+		return std::upper_bound(m_Container.begin(), m_Container.end(), obj);
+	}
+
+	// Calls func on every element from min up to, but not including, max
+	template <typename TFunc>
+	void forRange(const TType& min, const TType& max, TFunc&& func) const {
+		for (auto itr = lowerBound(min); itr != m_Container.end() && *itr < max; ++itr) {
+			func(*itr);
+		}
+	}
+
+	// The number of elements from min up to, but not including, max
+	[[nodiscard]] size_t countRange(const TType& min, const TType& max) const {
+		const auto first = lowerBound(min);
+		return static_cast<size_t>(std::lower_bound(first, m_Container.end(), max) - first);
+	}
+
+	// Elements can't be changed through an iterator, as that could break the order
+	using value_type = typename std::vector<TType, TAllocator>::value_type;
+	using iterator = typename std::vector<TType, TAllocator>::const_iterator;
+	using const_iterator = typename std::vector<TType, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::vector<TType, TAllocator>::const_reverse_iterator;
+	using const_reverse_iterator = typename std::vector<TType, TAllocator>::const_reverse_iterator;
+
+	iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() const { return m_Container.rbegin(); }
+	reverse_iterator rend() const { return m_Container.rend(); }
+
+protected:
+
+	template <typename TOtherType>
+	typename std::vector<TType, TAllocator>::iterator insert(TOtherType&& obj) {
+		auto itr = std::lower_bound(m_Container.begin(), m_Container.end(), obj);
+		if (itr != m_Container.end() && !(obj < *itr)) return itr;
+		return m_Container.insert(itr, std::forward<TOtherType>(obj));
+	}
+
+	// Sorts the elements from start on, unless isSorted says they already are, and merges them into the sorted ones before, dropping any that are equal to an earlier one
+	// Stable, so when elements are equal the one that was already there wins
+	void sortFrom(const size_t start, const bool isSorted = false) {
+		const auto middle = m_Container.begin() + static_cast<std::ptrdiff_t>(start);
+		if (!isSorted) {
+			std::stable_sort(middle, m_Container.end());
+		}
+		std::inplace_merge(m_Container.begin(), middle, m_Container.end());
+		m_Container.erase(std::unique(m_Container.begin(), m_Container.end(), [](const TType& fst, const TType& snd) {
+			return !(fst < snd);
+		}), m_Container.end());
+	}
+
+	auto findPointer(typename TUnfurled<TType>::Type* obj) {
+		return std::find_if(m_Container.begin(), m_Container.end(), [&](const TType& element) {
+			return std::invoke(TUnfurled<TType>::get, element) == obj;
+		});
+	}
+
+	auto findPointer(typename TUnfurled<TType>::Type* obj) const {
+		return std::find_if(m_Container.begin(), m_Container.end(), [&](const TType& element) {
+			return std::invoke(TUnfurled<TType>::get, element) == obj;
+		});
+	}
+
+	// The element is taken out before it is pushed, since otr may be this set
+	template <typename TIterator>
+	void moveTo(TSingleAssociativeContainer<TType>& otr, TIterator itr) {
+		// Prefer move, but copy if not available
+		if constexpr (std::is_move_constructible_v<TType>) {
+			TType obj = std::move(*itr);
+			m_Container.erase(itr);
+			otr.push(std::move(obj));
+		} else {
+			TType obj = *itr;
+			m_Container.erase(itr);
+			otr.push(obj);
+		}
+	}
+
+	std::vector<TType, TAllocator> m_Container;
+};
+
+template <typename TType, typename... TArgs>
+TFlatPrioritySet(TType, TArgs...) -> TFlatPrioritySet<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TFlatPrioritySet = ::TFlatPrioritySet<TType, std::pmr::polymorphic_allocator<TType>>;
+}
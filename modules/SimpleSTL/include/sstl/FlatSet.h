@@ -0,0 +1,253 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <functional>
+#include "Container.h"
+#include "FlatHashTable.h"
+#include "sutil/InitializerList.h"
+#include "sutil/Hashing.h"
+
+// A set kept in one flat array rather than in separately allocated nodes, a drop in replacement for TSet
+// Elements move when the set grows or is rehashed, so references to them only last until the next push
+template <typename TType, typename TAllocator = std::allocator<TType>,
+	std::enable_if_t<sutil::is_hashable_v<TType>, int> = 0
+>
+struct TFlatSet : TSingleAssociativeContainer<TType> {
+
+	TFlatSet() = default;
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TFlatSet(TInitializerList<TType> init) {
+		m_Container.reserve(init.size());
+		for (auto& obj : init) {
+			m_Container.insert(obj);
+		}
+	}
+
+	// Kept from taking an allocator, which goes to the constructor below
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
+	>
+	explicit TFlatSet(TArgs&&... args) {
+		m_Container.reserve(sizeof...(TArgs));
+		(m_Container.emplace(std::forward<TArgs>(args)), ...);
+	}
+
+	explicit TFlatSet(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
+
+	// The number of slots, which is what the set takes in memory along with a control byte for each
+	[[nodiscard]] size_t getCapacity() const { return m_Container.capacity(); }
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Container.size();
+	}
+
+	virtual const TType& top() const override {
+		return *m_Container.begin();
+	}
+
+	virtual const TType& bottom() const override {
+		return m_Container.back();
+	}
+
+	virtual bool contains(const TType& obj) const override {
+		return m_Container.contains(obj);
+	}
+
+	virtual bool contains(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			return findPointer(obj) != m_Container.end();
+		} else {
+			return contains(*obj);
+		}
+	}
+
+	virtual void resize(const size_t amt) override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			for (size_t i = getSize(); i < amt; ++i) {
+				m_Container.emplace();
+			}
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void resize(const size_t amt, std::function<TType()> func) override {
+		m_Container.reserve(amt);
+		for (size_t i = getSize(); i < amt; ++i) {
+			m_Container.insert(func());
+		}
+	}
+
+	virtual void reserve(const size_t amt) override {
+		m_Container.reserve(amt);
+	}
+
+	// Reserves once for every element, so the table never rehashes partway through
+	virtual void pushRange(TType* objs, const size_t count, const bool = false) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			m_Container.reserve(getSize() + count);
+			for (size_t i = 0; i < count; ++i) {
+				m_Container.insert(std::move(objs[i]));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual const TType& push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			return *m_Container.emplace().first;
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void push(const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			m_Container.insert(obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			m_Container.insert(std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void replace(const TType& tgt, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			pop(tgt);
+			m_Container.insert(obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const TType& tgt, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			pop(tgt);
+			m_Container.insert(std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Keeps the slots, so refilling the set doesn't allocate
+	virtual void clear() override {
+		m_Container.clear();
+	}
+
+	virtual void pop() override {
+		m_Container.erase(m_Container.begin());
+	}
+
+	virtual void pop(const TType& obj) override {
+		m_Container.erase(obj);
+	}
+
+	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			if (auto itr = findPointer(obj); itr != m_Container.end()) {
+				m_Container.erase(itr);
+			}
+		} else {
+			pop(*obj);
+		}
+	}
+
+	virtual void transfer(TSingleAssociativeContainer<TType>& otr, TType& obj) override {
+		auto itr = m_Container.find(obj);
+		if (itr == m_Container.end()) return;
+		moveTo(otr, itr);
+	}
+
+	virtual void transfer(TSingleAssociativeContainer<TType>& otr, typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			auto itr = findPointer(obj);
+			if (itr == m_Container.end()) return;
+			moveTo(otr, itr);
+		} else {
+			transfer(otr, *obj);
+		}
+	}
+
+	virtual void forEach(const std::function<void(const TType&)>& func) const override {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+protected:
+
+	struct GetKey {
+		static const TType& get(const TType& obj) { return obj; }
+	};
+
+	sstl::TFlatHashTable<TType, TType, GetKey, TAllocator> m_Container;
+
+	// Managed pointers are found by what they point to, which isn't what they are hashed by
+	auto findPointer(typename TUnfurled<TType>::Type* obj) {
+		return std::find_if(m_Container.begin(), m_Container.end(), [&](const TType& element) {
+			return std::invoke(TUnfurled<TType>::get, element) == obj;
+		});
+	}
+
+	auto findPointer(typename TUnfurled<TType>::Type* obj) const {
+		return std::find_if(m_Container.begin(), m_Container.end(), [&](const TType& element) {
+			return std::invoke(TUnfurled<TType>::get, element) == obj;
+		});
+	}
+
+	// The element is taken out before it is pushed, since otr may be this set
+	template <typename TIterator>
+	void moveTo(TSingleAssociativeContainer<TType>& otr, TIterator itr) {
+		// Prefer move, but copy if not available
+		if constexpr (std::is_move_constructible_v<TType>) {
+			TType obj = std::move(*itr);
+			m_Container.erase(itr);
+			otr.push(std::move(obj));
+		} else {
+			TType obj = *itr;
+			m_Container.erase(itr);
+			otr.push(obj);
+		}
+	}
+
+public:
+
+	using value_type = typename decltype(m_Container)::value_type;
+	using iterator = typename decltype(m_Container)::const_iterator;
+	using const_iterator = typename decltype(m_Container)::const_iterator;
+
+	// Elements can't be changed through an iterator, as that would change their hash
+	iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+};
+
+template <typename TType, typename... TArgs>
+TFlatSet(TType, TArgs...) -> TFlatSet<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TFlatSet = ::TFlatSet<TType, std::pmr::polymorphic_allocator<TType>>;
+}
@@ -4,7 +4,7 @@
 #include "Container.h"
 #include "sutil/InitializerList.h"
 
-template <typename TType>
+template <typename TType, typename TAllocator = std::allocator<TType>>
 struct TForwardList : TSequenceContainer<TType> {
 
 	TForwardList() = default;
@@ -14,14 +14,19 @@ struct TForwardList : TSequenceContainer<TType> {
 	>
 	TForwardList(TInitializerList<TType> init): m_Container(init) {}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
 	explicit TForwardList(TArgs&&... args) {
 		(m_Container.emplace_front(std::forward<TArgs>(args)), ...);
 	}
 
-	TForwardList(const std::forward_list<TType>& otr): m_Container(otr) {}
+	TForwardList(const std::forward_list<TType, TAllocator>& otr): m_Container(otr) {}
+
+	explicit TForwardList(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
 
 	[[nodiscard]] virtual size_t getSize() const override {
 		return SIZE(m_Container);
@@ -217,10 +222,45 @@ struct TForwardList : TSequenceContainer<TType> {
 		}
 	}
 
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	using value_type = typename std::forward_list<TType, TAllocator>::value_type;
+	using iterator = typename std::forward_list<TType, TAllocator>::iterator;
+	using const_iterator = typename std::forward_list<TType, TAllocator>::const_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
 protected:
 
-	std::forward_list<TType> m_Container;
+	std::forward_list<TType, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
 TForwardList(TType, TArgs...) -> TForwardList<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TForwardList = ::TForwardList<TType, std::pmr::polymorphic_allocator<TType>>;
+}
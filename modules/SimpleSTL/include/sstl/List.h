@@ -4,7 +4,7 @@
 #include "Container.h"
 #include "sutil/InitializerList.h"
 
-template <typename TType>
+template <typename TType, typename TAllocator = std::allocator<TType>>
 struct TList : TSequenceContainer<TType> {
 
 	TList() = default;
@@ -14,14 +14,19 @@ struct TList : TSequenceContainer<TType> {
 	>
 	TList(TInitializerList<TType> init): m_Container(init) {}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
 	explicit TList(TArgs&&... args) {
 		(m_Container.emplace_back(std::forward<TArgs>(args)), ...);
 	}
 
-	TList(const std::list<TType>& otr): m_Container(otr) {}
+	TList(const std::list<TType, TAllocator>& otr): m_Container(otr) {}
+
+	explicit TList(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
 
 	[[nodiscard]] virtual size_t getSize() const override {
 		return m_Container.size();
@@ -239,10 +244,69 @@ struct TList : TSequenceContainer<TType> {
 		}
 	}
 
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		size_t i = getSize() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		size_t i = getSize() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	using value_type = typename std::list<TType, TAllocator>::value_type;
+	using iterator = typename std::list<TType, TAllocator>::iterator;
+	using const_iterator = typename std::list<TType, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::list<TType, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::list<TType, TAllocator>::const_reverse_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
 protected:
 
-	std::list<TType> m_Container;
+	std::list<TType, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
 TList(TType, TArgs...) -> TList<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TList = ::TList<TType, std::pmr::polymorphic_allocator<TType>>;
+}
@@ -5,7 +5,7 @@
 #include "sutil/InitializerList.h"
 #include "sutil/Hashing.h"
 
-template <typename TKeyType, typename TValueType,
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<const TKeyType, TValueType>>,
 	std::enable_if_t<sutil::is_hashable_v<TKeyType>, int> = 0
 >
 struct TMap : TAssociativeContainer<TKeyType, TValueType> {
@@ -22,7 +22,10 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
-	template <typename... TPairs>
+	// Kept from taking an allocator, which goes to the constructor below
+	template <typename... TPairs,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_convertible<TPairs, TAllocator>>...>, int> = 0
+	>
 	explicit TMap(TPairs&&... args) {
 		m_Container.reserve(sizeof...(TPairs));
 		(m_Container.emplace(std::forward<typename TPairs::KeyType>(args.first), std::forward<typename TPairs::ValueType>(args.second)), ...);
@@ -30,6 +33,10 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	TMap(const std::unordered_map<TKeyType, TValueType>& otr): m_Container(otr) {}
 
+	explicit TMap(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
+
 	[[nodiscard]] virtual size_t getSize() const override {
 		return m_Container.size();
 	}
@@ -39,8 +46,11 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 	}
 
 	virtual TPair<TKeyType, const TValueType&> bottom() const override {
-		auto itr = m_Container.end();
-		--itr;
+		// Unordered iterators can't go backwards, so walk forward to the last element
+		auto itr = m_Container.begin();
+		for (auto next = std::next(itr); next != m_Container.end(); ++next) {
+			itr = next;
+		}
 		return TPair<TKeyType, const TValueType&>{*itr};
 	}
 
@@ -68,6 +78,18 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 		m_Container.reserve(amt);
 	}
 
+	// Reserves once for every pair, so the table never rehashes partway through
+	virtual void pushRange(TPair<TKeyType, TValueType>* pairs, const size_t count, const bool = false) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			m_Container.reserve(getSize() + count);
+			for (size_t i = 0; i < count; ++i) {
+				m_Container.emplace(std::move(pairs[i].first), std::move(pairs[i].second));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
 	virtual TPair<TKeyType, const TValueType&> push() override {
 		if constexpr (std::is_default_constructible_v<TKeyType> && std::is_default_constructible_v<TValueType>) {
 			m_Container.emplace();
@@ -166,6 +188,14 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
 protected:
 
 	struct Hasher {
@@ -174,11 +204,32 @@ protected:
 		}
 	};
 
-	std::unordered_map<TKeyType, TValueType, Hasher> m_Container;
+	std::unordered_map<TKeyType, TValueType, Hasher, std::equal_to<TKeyType>, TAllocator> m_Container;
+
+public:
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	// Declared after the container, as its type depends on the Hasher
+	using value_type = typename decltype(m_Container)::value_type;
+	using iterator = typename decltype(m_Container)::iterator;
+	using const_iterator = typename decltype(m_Container)::const_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
 };
 
 template <typename TKeyType, typename TValueType>
 TMap(TInitializerList<TPair<TKeyType, TValueType>>) -> TMap<TKeyType, TValueType>;
 
 template <typename TPair, typename... TPairs>
-TMap(TPair, TPairs...) -> TMap<typename TPair::KeyType, typename TPair::ValueType>;
\ No newline at end of file
+TMap(TPair, TPairs...) -> TMap<typename TPair::KeyType, typename TPair::ValueType>;
+
+namespace sstl::pmr {
+	template <typename TKeyType, typename TValueType>
+	using TMap = ::TMap<TKeyType, TValueType, std::pmr::polymorphic_allocator<std::pair<const TKeyType, TValueType>>>;
+}
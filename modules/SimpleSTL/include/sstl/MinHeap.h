@@ -4,66 +4,69 @@
 #include "Vector.h"
 
 // Priority Vector is a vector that makes itself into a max heap, it is guaranteed the top value is always the largest
-template <typename TType>
-struct TMinHeap : TVector<TType> {
+template <typename TType, typename TAllocator = std::allocator<TType>>
+struct TMinHeap : TVector<TType, TAllocator> {
 
-	using TVector<TType>::m_Container;
+	using TVector<TType, TAllocator>::m_Container;
 	
 	_CONSTEXPR20 TMinHeap() = default;
 
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
-	_CONSTEXPR20 TMinHeap(TInitializerList<TType> init): TVector<TType>(init) {
+	_CONSTEXPR20 TMinHeap(TInitializerList<TType> init): TVector<TType, TAllocator>(init) {
 		std::make_heap(m_Container.begin(), m_Container.end(), std::less<TType>{});
 	}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
-	_CONSTEXPR20 explicit TMinHeap(TArgs&&... args): TVector<TType>(std::forward<TArgs>(args)...) {
+	_CONSTEXPR20 explicit TMinHeap(TArgs&&... args): TVector<TType, TAllocator>(std::forward<TArgs>(args)...) {
 		std::make_heap(m_Container.begin(), m_Container.end(), std::less<TType>{});
 	}
 
-	_CONSTEXPR20 TMinHeap(const std::vector<TType>& otr): TVector<TType>::m_Container(otr) {
+	_CONSTEXPR20 TMinHeap(const std::vector<TType, TAllocator>& otr): TVector<TType, TAllocator>::m_Container(otr) {
 		std::make_heap(m_Container.begin(), m_Container.end(), std::less<TType>{});
 	}
 
+	_CONSTEXPR20 explicit TMinHeap(const TAllocator& allocator): TVector<TType, TAllocator>(allocator) {}
+
 	virtual void resize(size_t amt) override {
-		TVector<TType>::resize(amt);
+		TVector<TType, TAllocator>::resize(amt);
 		std::make_heap(m_Container.begin(), m_Container.end(), MinCmp{});
 	}
 
 	virtual void resize(size_t amt, std::function<TType(size_t)> func) override {
-		TVector<TType>::resize(amt, func);
+		TVector<TType, TAllocator>::resize(amt, func);
 		std::make_heap(m_Container.begin(), m_Container.end(), MinCmp{});
 	}
 
 	virtual TType& push() override {
-		TVector<TType>::push();
+		TVector<TType, TAllocator>::push();
 		std::push_heap(m_Container.begin(), m_Container.end(), MinCmp{});
-		return TVector<TType>::get(TVector<TType>::getSize() - 1);
+		return TVector<TType, TAllocator>::get(TVector<TType, TAllocator>::getSize() - 1);
 	}
 
 	virtual size_t push(const TType& obj) override {
-		TVector<TType>::push(obj);
+		TVector<TType, TAllocator>::push(obj);
 		std::push_heap(m_Container.begin(), m_Container.end(), MinCmp{});
-		return TVector<TType>::getSize() - 1;
+		return TVector<TType, TAllocator>::getSize() - 1;
 	}
 
 	virtual size_t push(TType&& obj) override {
-		TVector<TType>::push(std::move(obj));
+		TVector<TType, TAllocator>::push(std::move(obj));
 		std::push_heap(m_Container.begin(), m_Container.end(), MinCmp{});
-		return TVector<TType>::getSize() - 1;
+		return TVector<TType, TAllocator>::getSize() - 1;
 	}
 
 	virtual void pop() override {
 		std::pop_heap(m_Container.begin(), m_Container.end(), MinCmp{});
-		TVector<TType>::pop();
+		TVector<TType, TAllocator>::pop();
 	}
 
 	virtual void pop(const TType& obj) override {
-		TVector<TType>::pop(obj);
+		TVector<TType, TAllocator>::pop(obj);
 		std::make_heap(m_Container.begin(), m_Container.end(), MinCmp{});
 	}
 
@@ -76,6 +79,21 @@ struct TMinHeap : TVector<TType> {
 		}
 	}
 
+	// Elements can't be changed through an iterator, as that could break the heap
+	using iterator = typename std::vector<TType, TAllocator>::const_iterator;
+	using const_iterator = typename std::vector<TType, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::vector<TType, TAllocator>::const_reverse_iterator;
+	using const_reverse_iterator = typename std::vector<TType, TAllocator>::const_reverse_iterator;
+
+	iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() const { return m_Container.rbegin(); }
+	reverse_iterator rend() const { return m_Container.rend(); }
+
 protected:
 
 	virtual void push(const size_t index, const TType& obj) override {
@@ -87,7 +105,7 @@ protected:
 	}
 
 	virtual void popAt(const size_t index) override {
-		TVector<TType>::popAt(index);
+		TVector<TType, TAllocator>::popAt(index);
 		std::make_heap(m_Container.begin(), m_Container.end(), MinCmp{});
 	}
 
@@ -100,3 +118,8 @@ protected:
 
 template <typename TType, typename... TArgs>
 TMinHeap(TType, TArgs...) -> TMinHeap<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TMinHeap = ::TMinHeap<TType, std::pmr::polymorphic_allocator<TType>>;
+}
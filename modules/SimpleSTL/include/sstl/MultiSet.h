@@ -5,7 +5,7 @@
 #include "sutil/InitializerList.h"
 #include "sutil/Hashing.h"
 
-template <typename TType,
+template <typename TType, typename TAllocator = std::allocator<TType>,
           std::enable_if_t<sutil::is_hashable_v<TType>, int> = 0
 >
 struct TMultiSet : TSingleAssociativeContainer<TType> {
@@ -17,8 +17,9 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 	>
 	TMultiSet(TInitializerList<TType> init): m_Container(init) {}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
 	explicit TMultiSet(TArgs&&... args) {
 		m_Container.reserve(sizeof...(TArgs));
@@ -27,6 +28,10 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 
 	TMultiSet(const std::unordered_multiset<TType>& otr): m_Container(otr) {}
 
+	explicit TMultiSet(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
+
 	[[nodiscard]] virtual size_t getSize() const override {
 		return m_Container.size();
 	}
@@ -36,8 +41,11 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 	}
 
 	virtual const TType& bottom() const override {
-		auto itr = m_Container.end();
-		--itr;
+		// Unordered iterators can't go backwards, so walk forward to the last element
+		auto itr = m_Container.begin();
+		for (auto next = std::next(itr); next != m_Container.end(); ++next) {
+			itr = next;
+		}
 		return *itr;
 	}
 
@@ -73,6 +81,18 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 		m_Container.reserve(amt);
 	}
 
+	// Reserves once for every element, so the table never rehashes partway through
+	virtual void pushRange(TType* objs, const size_t count, const bool = false) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			m_Container.reserve(getSize() + count);
+			for (size_t i = 0; i < count; ++i) {
+				m_Container.emplace(std::move(objs[i]));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
 	virtual const TType& push() override {
 		if constexpr (std::is_default_constructible_v<TType>) {
 			m_Container.emplace();
@@ -169,6 +189,14 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
 protected:
 
 	struct Hasher {
@@ -177,8 +205,29 @@ protected:
 		}
 	};
 
-	std::unordered_multiset<TType, Hasher> m_Container;
+	std::unordered_multiset<TType, Hasher, std::equal_to<TType>, TAllocator> m_Container;
+
+public:
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	// Declared after the container, as its type depends on the Hasher
+	using value_type = typename decltype(m_Container)::value_type;
+	using iterator = typename decltype(m_Container)::iterator;
+	using const_iterator = typename decltype(m_Container)::const_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
 };
 
 template <typename TType, typename... TArgs>
 TMultiSet(TType, TArgs...) -> TMultiSet<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TMultiSet = ::TMultiSet<TType, std::pmr::polymorphic_allocator<TType>>;
+}
@@ -1,10 +1,11 @@
 ﻿#pragma once
 
+#include <algorithm>
 #include <map>
 #include "Container.h"
 #include "sutil/InitializerList.h"
 
-template <typename TKeyType, typename TValueType,
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<const TKeyType, TValueType>>,
           std::enable_if_t<sutil::is_less_than_comparable_v<TKeyType>, int> = 0
 >
 struct TPriorityMultiMap : TAssociativeContainer<TKeyType, TValueType> {
@@ -20,12 +21,20 @@ struct TPriorityMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
-	template <typename... TPairs>
+	// Kept from taking an allocator, which goes to the constructor below
+	template <typename... TPairs,
+		std::enable_if_t<std::conjunction_v<std::negation<std::is_convertible<TPairs, TAllocator>>...>, int> = 0
+	>
 	explicit TPriorityMultiMap(TPairs&&... args) {
-		(m_Container.emplace(std::forward<typename TPairs::KeyType>(args.first), std::forward<typename TPairs::ValueType>(args.second)), ...);
+		// Pairs given in order are each appended without searching the tree
+		(m_Container.emplace_hint(m_Container.end(), std::forward<typename TPairs::KeyType>(args.first), std::forward<typename TPairs::ValueType>(args.second)), ...);
 	}
 
-	TPriorityMultiMap(const std::multimap<TKeyType, TValueType>& otr): m_Container(otr) {}
+	TPriorityMultiMap(const std::multimap<TKeyType, TValueType, std::less<TKeyType>, TAllocator>& otr): m_Container(otr) {}
+
+	explicit TPriorityMultiMap(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
 
 	[[nodiscard]] virtual size_t getSize() const override {
 		return m_Container.size();
@@ -60,6 +69,26 @@ struct TPriorityMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Once sorted, each pair is placed right after the last one, so the tree is rarely searched
+	virtual void pushRange(TPair<TKeyType, TValueType>* pairs, const size_t count, const bool isSorted = false) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			if constexpr (std::is_move_assignable_v<TPair<TKeyType, TValueType>>) {
+				const auto keyLess = [](const TPair<TKeyType, TValueType>& fst, const TPair<TKeyType, TValueType>& snd) {
+					return fst.first < snd.first;
+				};
+				if (!isSorted && !std::is_sorted(pairs, pairs + count, keyLess)) {
+					std::stable_sort(pairs, pairs + count, keyLess);
+				}
+			}
+			auto hint = m_Container.end();
+			for (size_t i = 0; i < count; ++i) {
+				hint = std::next(m_Container.emplace_hint(hint, std::move(pairs[i].first), std::move(pairs[i].second)));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
 	virtual TPair<TKeyType, const TValueType&> push() override {
 		if constexpr (std::is_default_constructible_v<TKeyType> && std::is_default_constructible_v<TValueType>) {
 			m_Container.emplace();
@@ -158,13 +187,47 @@ struct TPriorityMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	using value_type = typename std::multimap<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::value_type;
+	using iterator = typename std::multimap<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::iterator;
+	using const_iterator = typename std::multimap<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::multimap<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::multimap<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::const_reverse_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
 protected:
 
-	std::multimap<TKeyType, TValueType> m_Container;
+	std::multimap<TKeyType, TValueType, std::less<TKeyType>, TAllocator> m_Container;
 };
 
 template <typename TKeyType, typename TValueType>
 TPriorityMultiMap(TInitializerList<TPair<TKeyType, TValueType>>) -> TPriorityMultiMap<TKeyType, TValueType>;
 
 template <typename TPair, typename... TPairs>
-TPriorityMultiMap(TPair, TPairs...) -> TPriorityMultiMap<typename TPair::KeyType, typename TPair::ValueType>;
\ No newline at end of file
+TPriorityMultiMap(TPair, TPairs...) -> TPriorityMultiMap<typename TPair::KeyType, typename TPair::ValueType>;
+
+namespace sstl::pmr {
+	template <typename TKeyType, typename TValueType>
+	using TPriorityMultiMap = ::TPriorityMultiMap<TKeyType, TValueType, std::pmr::polymorphic_allocator<std::pair<const TKeyType, TValueType>>>;
+}
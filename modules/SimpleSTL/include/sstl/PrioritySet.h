@@ -1,10 +1,11 @@
 ﻿#pragma once
 
+#include <algorithm>
 #include <set>
 #include "Container.h"
 #include "sutil/InitializerList.h"
 
-template <typename TType,
+template <typename TType, typename TAllocator = std::allocator<TType>,
           std::enable_if_t<sutil::is_less_than_comparable_v<TType>, int> = 0
 >
 struct TPrioritySet : TSingleAssociativeContainer<TType> {
@@ -16,14 +17,20 @@ struct TPrioritySet : TSingleAssociativeContainer<TType> {
 	>
 	TPrioritySet(TInitializerList<TType> init): m_Container(init) {}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
 	explicit TPrioritySet(TArgs&&... args) {
-		(m_Container.emplace(std::forward<TArgs>(args)), ...);
+		// Elements given in order are each appended without searching the tree
+		(m_Container.emplace_hint(m_Container.end(), std::forward<TArgs>(args)), ...);
 	}
 
-	TPrioritySet(const std::set<TType>& otr): m_Container(otr) {}
+	TPrioritySet(const std::set<TType, std::less<TType>, TAllocator>& otr): m_Container(otr) {}
+
+	explicit TPrioritySet(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
 
 	[[nodiscard]] virtual size_t getSize() const override {
 		return m_Container.size();
@@ -67,6 +74,23 @@ struct TPrioritySet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Once sorted, each element is placed right after the last one, so the tree is rarely searched
+	virtual void pushRange(TType* objs, const size_t count, const bool isSorted = false) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			if constexpr (std::is_move_assignable_v<TType>) {
+				if (!isSorted && !std::is_sorted(objs, objs + count)) {
+					std::stable_sort(objs, objs + count);
+				}
+			}
+			auto hint = m_Container.end();
+			for (size_t i = 0; i < count; ++i) {
+				hint = std::next(m_Container.emplace_hint(hint, std::move(objs[i])));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
 	virtual const TType& push() override {
 		if constexpr (std::is_default_constructible_v<TType>) {
 			m_Container.emplace();
@@ -163,10 +187,44 @@ struct TPrioritySet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	using value_type = typename std::set<TType, std::less<TType>, TAllocator>::value_type;
+	using iterator = typename std::set<TType, std::less<TType>, TAllocator>::iterator;
+	using const_iterator = typename std::set<TType, std::less<TType>, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::set<TType, std::less<TType>, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::set<TType, std::less<TType>, TAllocator>::const_reverse_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
 protected:
 
-	std::set<TType> m_Container;
+	std::set<TType, std::less<TType>, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
 TPrioritySet(TType, TArgs...) -> TPrioritySet<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TPrioritySet = ::TPrioritySet<TType, std::pmr::polymorphic_allocator<TType>>;
+}
@@ -3,24 +3,31 @@
 #include "Deque.h"
 
 // std::queue is already a wrapper around a deque, so we do that here too, and skip std::queue's own abstraction
-template <typename TType>
-struct TQueue : TDeque<TType> {
+template <typename TType, typename TAllocator = std::allocator<TType>>
+struct TQueue : TDeque<TType, TAllocator> {
 
-	using TDeque<TType>::m_Container;
+	using TDeque<TType, TAllocator>::m_Container;
+
+	// Brings in the templated overloads, which would otherwise be hidden by the overrides below
+	using TDeque<TType, TAllocator>::forEach;
+	using TDeque<TType, TAllocator>::forEachReverse;
 	
 	TQueue() = default;
 
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
-	TQueue(TInitializerList<TType> init): TDeque<TType>(init) {}
+	TQueue(TInitializerList<TType> init): TDeque<TType, TAllocator>(init) {}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
-	explicit TQueue(TArgs&&... args): TDeque<TType>(std::forward<TArgs>(args)...) {}
+	explicit TQueue(TArgs&&... args): TDeque<TType, TAllocator>(std::forward<TArgs>(args)...) {}
+
+	TQueue(const std::deque<TType, TAllocator>& otr): TDeque<TType, TAllocator>::m_Container(otr) {}
 
-	TQueue(const std::deque<TType>& otr): TDeque<TType>::m_Container(otr) {}
+	explicit TQueue(const TAllocator& allocator): TDeque<TType, TAllocator>(allocator) {}
 
 	virtual TType& top() override {
 		return m_Container.back();
@@ -33,7 +40,7 @@ struct TQueue : TDeque<TType> {
 	virtual size_t push(const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			m_Container.emplace_back(obj);
-			return TDeque<TType>::getSize() - 1;
+			return TDeque<TType, TAllocator>::getSize() - 1;
 		} else {
 			throw std::runtime_error("Type is not copyable");
 		}
@@ -42,7 +49,7 @@ struct TQueue : TDeque<TType> {
 	virtual size_t push(TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
 			m_Container.emplace_back(std::move(obj));
-			return TDeque<TType>::getSize() - 1;
+			return TDeque<TType, TAllocator>::getSize() - 1;
 		} else {
 			throw std::runtime_error("Type is not moveable");
 		}
@@ -50,8 +57,8 @@ struct TQueue : TDeque<TType> {
 
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
-			TDeque<TType>::popAt(index);
-			TDeque<TType>::push(index, obj);
+			TDeque<TType, TAllocator>::popAt(index);
+			TDeque<TType, TAllocator>::push(index, obj);
 		} else {
 			throw std::runtime_error("Type is not copyable");
 		}
@@ -59,15 +66,15 @@ struct TQueue : TDeque<TType> {
 
 	virtual void replace(const size_t index, TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
-			TDeque<TType>::popAt(index);
-			TDeque<TType>::push(index, std::move(obj));
+			TDeque<TType, TAllocator>::popAt(index);
+			TDeque<TType, TAllocator>::push(index, std::move(obj));
 		} else {
 			throw std::runtime_error("Type is not moveable");
 		}
 	}
 
 	virtual void pop() override {
-		TDeque<TType>::popAt(TDeque<TType>::getSize() - 1);
+		TDeque<TType, TAllocator>::popAt(TDeque<TType, TAllocator>::getSize() - 1);
 	}
 
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
@@ -85,14 +92,14 @@ struct TQueue : TDeque<TType> {
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
-		size_t i = TDeque<TType>::getSize() - 1;
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
-		size_t i = TDeque<TType>::getSize() - 1;
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
@@ -101,33 +108,38 @@ struct TQueue : TDeque<TType> {
 protected:
 
 	virtual TType& bottom() override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual const TType& bottom() const override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual TType& get(size_t index) override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual const TType& get(size_t index) const override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual void push(const size_t index, const TType& obj) override {
-		TDeque<TType>::push(index, obj);
+		TDeque<TType, TAllocator>::push(index, obj);
 	}
 
 	virtual void push(const size_t index, TType&& obj) override {
-		TDeque<TType>::push(index, std::move(obj));
+		TDeque<TType, TAllocator>::push(index, std::move(obj));
 	}
 
 	virtual void popAt(const size_t index) override {
-		TDeque<TType>::popAt(index);
+		TDeque<TType, TAllocator>::popAt(index);
 	}
 };
 
 template <typename TType, typename... TArgs>
 TQueue(TType, TArgs...) -> TQueue<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TQueue = ::TQueue<TType, std::pmr::polymorphic_allocator<TType>>;
+}
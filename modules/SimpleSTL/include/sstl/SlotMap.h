@@ -0,0 +1,327 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Container.h"
+#include "sutil/Hashing.h"
+
+// Refers to an element of a TSlotMap, staying the same while the element moves around inside the map
+// Once the element is popped the handle no longer matches its slot, even after the slot is reused
+struct SSlotHandle {
+	uint32_t index = 0;
+
+	// Odd while the slot holds an element, so zero never refers to anything
+	uint32_t generation = 0;
+
+	[[nodiscard]] uint64_t getId() const { return static_cast<uint64_t>(generation) << 32 | index; }
+
+	[[nodiscard]] static SSlotHandle fromId(const uint64_t id) {
+		return SSlotHandle{static_cast<uint32_t>(id), static_cast<uint32_t>(id >> 32)};
+	}
+
+	friend bool operator==(const SSlotHandle& fst, const SSlotHandle& snd) { return fst.getId() == snd.getId(); }
+
+	friend bool operator!=(const SSlotHandle& fst, const SSlotHandle& snd) { return fst.getId() != snd.getId(); }
+
+	friend bool operator<(const SSlotHandle& fst, const SSlotHandle& snd) { return fst.getId() < snd.getId(); }
+
+	friend size_t getHash(const SSlotHandle& handle) { return static_cast<size_t>(handle.getId()); }
+
+	friend CHashArchive& operator<<(CHashArchive& archive, const SSlotHandle& handle) {
+		archive += static_cast<size_t>(handle.getId());
+		return archive;
+	}
+};
+
+static_assert(sizeof(SSlotHandle) == sizeof(uint64_t), "Slot handles must fit in 64 bits!");
+
+// Keeps its elements packed together in one array, handing out a handle for each that can be checked without touching the element
+// Popping moves the last element into the gap, so iteration is always over a contiguous array, but in no particular order
+// Handles are chosen by the map, so the functions that push at a given key throw
+template <typename TType, typename TAllocator = std::allocator<TType>>
+struct TSlotMap : TAssociativeContainer<SSlotHandle, TType> {
+
+	TSlotMap() = default;
+
+	explicit TSlotMap(const TAllocator& allocator)
+	: m_Values(allocator), m_Owners(allocator), m_Slots(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Values.get_allocator(); }
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Values.size();
+	}
+
+	virtual TPair<SSlotHandle, const TType&> top() const override {
+		return TPair<SSlotHandle, const TType&>{getHandle(0), m_Values.front()};
+	}
+
+	virtual TPair<SSlotHandle, const TType&> bottom() const override {
+		return TPair<SSlotHandle, const TType&>{getHandle(m_Values.size() - 1), m_Values.back()};
+	}
+
+	virtual bool contains(const SSlotHandle& handle) const override {
+		// Generations are only odd while a slot is full, so an empty slot is never matched, whatever its generation
+		return (handle.generation & 1) && handle.index < m_Slots.size() && m_Slots[handle.index].generation == handle.generation;
+	}
+
+	// Null when the handle is stale, rather than throwing like get
+	[[nodiscard]] TType* find(const SSlotHandle& handle) {
+		return contains(handle) ? &m_Values[m_Slots[handle.index].value] : nullptr;
+	}
+
+	[[nodiscard]] const TType* find(const SSlotHandle& handle) const {
+		return contains(handle) ? &m_Values[m_Slots[handle.index].value] : nullptr;
+	}
+
+	virtual TType& get(const SSlotHandle& handle) override {
+		if (!contains(handle)) {
+			throw std::runtime_error("Handle is not in the slot map!");
+		}
+		return m_Values[m_Slots[handle.index].value];
+	}
+
+	virtual const TType& get(const SSlotHandle& handle) const override {
+		if (!contains(handle)) {
+			throw std::runtime_error("Handle is not in the slot map!");
+		}
+		return m_Values[m_Slots[handle.index].value];
+	}
+
+	// The handle of the element at a position in the packed array
+	[[nodiscard]] SSlotHandle getHandle(const size_t denseIndex) const {
+		const uint32_t slot = m_Owners[denseIndex];
+		return SSlotHandle{slot, m_Slots[slot].generation};
+	}
+
+	// The keys func gives are ignored, each element gets a new handle
+	virtual void resize(const size_t amt, std::function<TPair<SSlotHandle, TType>()> func) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			reserve(amt);
+			for (size_t i = getSize(); i < amt; ++i) {
+				emplace(std::move(func().second));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void reserve(const size_t amt) override {
+		m_Values.reserve(amt);
+		m_Owners.reserve(amt);
+		m_Slots.reserve(amt);
+	}
+
+	// Writes the handle each value was given back into its pair
+	virtual void pushRange(TPair<SSlotHandle, TType>* pairs, const size_t count, const bool = false) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			reserve(getSize() + count);
+			for (size_t i = 0; i < count; ++i) {
+				pairs[i].first = emplace(std::move(pairs[i].second));
+			}
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	template <typename... TArgs>
+	SSlotHandle emplace(TArgs&&... args) {
+		// A new slot goes on the free list first, so nothing is lost if the element fails to construct
+		if (m_FreeHead == NONE) {
+			if (m_Slots.size() >= NONE) {
+				throw std::runtime_error("Slot map is out of slots!");
+			}
+			m_Slots.push_back(SSlot{});
+			m_FreeHead = static_cast<uint32_t>(m_Slots.size() - 1);
+		}
+
+		const uint32_t slot = m_FreeHead;
+		m_Owners.push_back(slot);
+		try {
+			m_Values.emplace_back(std::forward<TArgs>(args)...);
+		} catch (...) {
+			m_Owners.pop_back();
+			throw;
+		}
+
+		SSlot& entry = m_Slots[slot];
+		m_FreeHead = entry.value;
+		entry.value = static_cast<uint32_t>(m_Values.size() - 1);
+		++entry.generation;
+		return SSlotHandle{slot, entry.generation};
+	}
+
+	SSlotHandle insert(const TType& obj) {
+		return emplace(obj);
+	}
+
+	SSlotHandle insert(TType&& obj) {
+		return emplace(std::move(obj));
+	}
+
+	virtual TPair<SSlotHandle, const TType&> push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			const SSlotHandle handle = emplace();
+			return TPair<SSlotHandle, const TType&>{handle, m_Values.back()};
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual TType& push(const SSlotHandle&) override {
+		throw std::runtime_error("Slot maps hand out their own handles, use insert or emplace!");
+	}
+
+	virtual TType& push(const SSlotHandle&, const TType&) override {
+		throw std::runtime_error("Slot maps hand out their own handles, use insert or emplace!");
+	}
+
+	virtual TType& push(const SSlotHandle&, TType&&) override {
+		throw std::runtime_error("Slot maps hand out their own handles, use insert or emplace!");
+	}
+
+	virtual void push(const TPair<SSlotHandle, TType>&) override {
+		throw std::runtime_error("Slot maps hand out their own handles, use insert or emplace!");
+	}
+
+	virtual void push(TPair<SSlotHandle, TType>&&) override {
+		throw std::runtime_error("Slot maps hand out their own handles, use insert or emplace!");
+	}
+
+	virtual void replace(const SSlotHandle& handle, const TType& obj) override {
+		if constexpr (std::is_copy_assignable_v<TType>) {
+			get(handle) = obj;
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const SSlotHandle& handle, TType&& obj) override {
+		if constexpr (std::is_move_assignable_v<TType>) {
+			get(handle) = std::move(obj);
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Every handle given out so far stops matching, the slots are kept for reuse
+	virtual void clear() override {
+		for (const uint32_t slot : m_Owners) {
+			release(slot);
+		}
+		m_Values.clear();
+		m_Owners.clear();
+	}
+
+	virtual void pop() override {
+		erase(0);
+	}
+
+	// Does nothing if the handle is stale
+	virtual void pop(const SSlotHandle& handle) override {
+		if (contains(handle)) {
+			erase(m_Slots[handle.index].value);
+		}
+	}
+
+	virtual void transfer(TAssociativeContainer<SSlotHandle, TType>& otr, const SSlotHandle& handle) override {
+		if (!contains(handle)) return;
+		const uint32_t denseIndex = m_Slots[handle.index].value;
+		// Prefer move, but copy if not available
+		if constexpr (std::is_move_constructible_v<TType>) {
+			TType obj = std::move(m_Values[denseIndex]);
+			erase(denseIndex);
+			otr.push(handle, std::move(obj));
+		} else {
+			TType obj = m_Values[denseIndex];
+			erase(denseIndex);
+			otr.push(handle, obj);
+		}
+	}
+
+	virtual void forEach(const std::function<void(TPair<SSlotHandle, const TType&>)>& func) const override {
+		for (size_t i = 0; i < m_Values.size(); ++i) {
+			func(TPair<SSlotHandle, const TType&>{getHandle(i), m_Values[i]});
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (size_t i = 0; i < m_Values.size(); ++i) {
+			func(TPair<SSlotHandle, const TType&>{getHandle(i), m_Values[i]});
+		}
+	}
+
+	// The packed elements, valid until the next push or pop
+	[[nodiscard]] TType* data() { return m_Values.data(); }
+	[[nodiscard]] const TType* data() const { return m_Values.data(); }
+
+protected:
+
+	constexpr static uint32_t NONE = UINT32_MAX;
+
+	struct SSlot {
+		// Where the element is in the packed array, or the next free slot when empty
+		uint32_t value = NONE;
+		uint32_t generation = 0;
+	};
+
+	template <typename TOtherType>
+	using TRebound = typename std::allocator_traits<TAllocator>::template rebind_alloc<TOtherType>;
+
+	// Moves the last element into the gap, then points the slot that owned it at its new place
+	void erase(const size_t denseIndex) {
+		const uint32_t slot = m_Owners[denseIndex];
+		const size_t last = m_Values.size() - 1;
+		if (denseIndex != last) {
+			m_Values[denseIndex] = std::move(m_Values[last]);
+			m_Owners[denseIndex] = m_Owners[last];
+			m_Slots[m_Owners[denseIndex]].value = static_cast<uint32_t>(denseIndex);
+		}
+		m_Values.pop_back();
+		m_Owners.pop_back();
+		release(slot);
+	}
+
+	// A slot whose generation has wrapped around is retired, so an old handle can never match it again
+	void release(const uint32_t slot) {
+		SSlot& entry = m_Slots[slot];
+		if (++entry.generation == 0) {
+			entry.value = NONE;
+			return;
+		}
+		entry.value = m_FreeHead;
+		m_FreeHead = slot;
+	}
+
+	std::vector<TType, TAllocator> m_Values;
+
+	// The slot of each packed element, so popping one can fix up the slot of the element moved into its place
+	std::vector<uint32_t, TRebound<uint32_t>> m_Owners;
+
+	std::vector<SSlot, TRebound<SSlot>> m_Slots;
+
+	uint32_t m_FreeHead = NONE;
+
+public:
+
+	using value_type = TType;
+	using iterator = typename std::vector<TType, TAllocator>::iterator;
+	using const_iterator = typename std::vector<TType, TAllocator>::const_iterator;
+
+	iterator begin() { return m_Values.begin(); }
+	const_iterator begin() const { return m_Values.begin(); }
+	const_iterator cbegin() const { return m_Values.cbegin(); }
+
+	iterator end() { return m_Values.end(); }
+	const_iterator end() const { return m_Values.end(); }
+	const_iterator cend() const { return m_Values.cend(); }
+};
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TSlotMap = ::TSlotMap<TType, std::pmr::polymorphic_allocator<TType>>;
+}
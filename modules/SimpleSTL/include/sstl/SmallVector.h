@@ -0,0 +1,456 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include "Container.h"
+#include "sutil/InitializerList.h"
+
+// A vector that keeps up to TSize elements inside of itself, and only allocates once it grows past that
+// Best for the many short lists that rarely grow, such as the edges of a single node
+template <typename TType, size_t TSize>
+struct TSmallVector : TSequenceContainer<TType> {
+
+	static_assert(TSize > 0, "TSmallVector needs room for at least one element, use TVector instead!");
+
+	TSmallVector() = default;
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TSmallVector(TInitializerList<TType> init) {
+		copyFrom(init.begin(), init.size());
+	}
+
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+	>
+	explicit TSmallVector(TArgs&&... args) {
+		reserve(sizeof...(TArgs));
+		(emplace_back(std::forward<TArgs>(args)), ...);
+	}
+
+	// Only allocates if otr has more elements than fit inline
+	TSmallVector(const TSmallVector& otr) {
+		copyFrom(otr.m_Data, otr.m_Size);
+	}
+
+	// Takes the memory of otr if it has allocated, otherwise the elements are moved one by one
+	TSmallVector(TSmallVector&& otr) noexcept(std::is_nothrow_move_constructible_v<TType>) {
+		if (otr.isInline()) {
+			std::uninitialized_move(otr.m_Data, otr.m_Data + otr.m_Size, m_Data);
+			m_Size = otr.m_Size;
+			otr.clear();
+		} else {
+			m_Data = otr.m_Data;
+			m_Size = otr.m_Size;
+			m_Capacity = otr.m_Capacity;
+			otr.m_Data = otr.getInline();
+			otr.m_Size = 0;
+			otr.m_Capacity = TSize;
+		}
+	}
+
+	// Reuses the memory already held when there is enough of it
+	TSmallVector& operator=(const TSmallVector& otr) {
+		if (this == &otr) return *this;
+		clear();
+		copyFrom(otr.m_Data, otr.m_Size);
+		return *this;
+	}
+
+	TSmallVector& operator=(TSmallVector&& otr) noexcept(std::is_nothrow_move_constructible_v<TType>) {
+		if (this == &otr) return *this;
+		if (otr.isInline()) {
+			clear();
+			reserve(otr.m_Size);
+			std::uninitialized_move(otr.m_Data, otr.m_Data + otr.m_Size, m_Data);
+			m_Size = otr.m_Size;
+			otr.clear();
+		} else {
+			clear();
+			deallocate();
+			m_Data = otr.m_Data;
+			m_Size = otr.m_Size;
+			m_Capacity = otr.m_Capacity;
+			otr.m_Data = otr.getInline();
+			otr.m_Size = 0;
+			otr.m_Capacity = TSize;
+		}
+		return *this;
+	}
+
+	virtual ~TSmallVector() override {
+		clear();
+		deallocate();
+	}
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Size;
+	}
+
+	// The amount of elements that can be held before allocating again
+	[[nodiscard]] size_t getCapacity() const { return m_Capacity; }
+
+	// True while the elements are still held inside of the vector itself
+	[[nodiscard]] bool isInline() const { return m_Data == getInline(); }
+
+	TType* data() { return m_Data; }
+
+	const TType* data() const { return m_Data; }
+
+	virtual TType& top() override {
+		return m_Data[0];
+	}
+
+	virtual const TType& top() const override {
+		return m_Data[0];
+	}
+
+	virtual TType& bottom() override {
+		return m_Data[m_Size - 1];
+	}
+
+	virtual const TType& bottom() const override {
+		return m_Data[m_Size - 1];
+	}
+
+	virtual bool contains(const TType& obj) const override {
+		return find(obj) != m_Size;
+	}
+
+	virtual bool contains(typename TUnfurled<TType>::Type* obj) const override {
+		return find(obj) != m_Size;
+	}
+
+	virtual size_t find(const TType& obj) const override {
+		if constexpr (sutil::is_equality_comparable_v<TType>) {
+			return std::find(m_Data, m_Data + m_Size, obj) - m_Data;
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual size_t find(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Will compare pointers, is always comparable
+			return std::find_if(m_Data, m_Data + m_Size, [&](const TType& otr) { return std::invoke(TUnfurled<TType>::get, otr) == obj; }) - m_Data;
+		} else {
+			return find(*obj);
+		}
+	}
+
+	virtual TType& get(size_t index) override {
+		return m_Data[index];
+	}
+
+	virtual const TType& get(size_t index) const override {
+		return m_Data[index];
+	}
+
+	virtual TType& operator[](const size_t index) override {
+		return m_Data[index];
+	}
+
+	virtual const TType& operator[](const size_t index) const override {
+		return m_Data[index];
+	}
+
+	virtual void resize(size_t amt) override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			if (amt < m_Size) {
+				std::destroy(m_Data + amt, m_Data + m_Size);
+			} else {
+				reserve(amt);
+				std::uninitialized_value_construct(m_Data + m_Size, m_Data + amt);
+			}
+			m_Size = amt;
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
+		reserve(amt);
+		for (size_t i = m_Size; i < amt; ++i) {
+			emplace_back(func(i));
+		}
+	}
+
+	// Never shrinks, and does nothing while amt still fits
+	virtual void reserve(size_t amt) override {
+		if (amt > m_Capacity) {
+			reallocate(amt);
+		}
+	}
+
+	virtual TType& push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			return emplace_back();
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual size_t push(const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			emplace_back(obj);
+			return m_Size - 1;
+		} else {
+			throw std::runtime_error("Type is not copyable");
+		}
+	}
+
+	virtual size_t push(TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			emplace_back(std::move(obj));
+			return m_Size - 1;
+		} else {
+			throw std::runtime_error("Type is not moveable");
+		}
+	}
+
+	virtual void push(const size_t index, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			emplace_back(obj);
+			std::rotate(m_Data + index, m_Data + m_Size - 1, m_Data + m_Size);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(const size_t index, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			emplace_back(std::move(obj));
+			std::rotate(m_Data + index, m_Data + m_Size - 1, m_Data + m_Size);
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void replace(const size_t index, const TType& obj) override {
+		if constexpr (std::is_copy_assignable_v<TType>) {
+			m_Data[index] = obj;
+		} else if constexpr (std::is_copy_constructible_v<TType>) {
+			popAt(index);
+			push(index, obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const size_t index, TType&& obj) override {
+		if constexpr (std::is_move_assignable_v<TType>) {
+			m_Data[index] = std::move(obj);
+		} else if constexpr (std::is_move_constructible_v<TType>) {
+			popAt(index);
+			push(index, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Keeps any memory that was allocated, so refilling it does not allocate again
+	virtual void clear() override {
+		std::destroy(m_Data, m_Data + m_Size);
+		m_Size = 0;
+	}
+
+	virtual void pop() override {
+		popAt(static_cast<size_t>(0));
+	}
+
+	virtual void popAt(const size_t index) override {
+		std::move(m_Data + index + 1, m_Data + m_Size, m_Data + index);
+		--m_Size;
+		std::destroy_at(m_Data + m_Size);
+	}
+
+	virtual void pop(const TType& obj) override {
+		if constexpr (sutil::is_equality_comparable_v<TType>) {
+			if (const size_t index = find(obj); index != m_Size) {
+				popAt(index);
+			}
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
+		if (const size_t index = find(obj); index != m_Size) {
+			popAt(index);
+		}
+	}
+
+	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	using TSequenceContainer<TType>::doFor;
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	// Iterators are plain pointers, so they are invalidated whenever the vector grows past its capacity
+	using value_type = TType;
+	using iterator = TType*;
+	using const_iterator = const TType*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	iterator begin() { return m_Data; }
+	const_iterator begin() const { return m_Data; }
+	const_iterator cbegin() const { return m_Data; }
+
+	iterator end() { return m_Data + m_Size; }
+	const_iterator end() const { return m_Data + m_Size; }
+	const_iterator cend() const { return m_Data + m_Size; }
+
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	// The names std::vector uses, so it can stand in for one in code written against std::vector
+	[[nodiscard]] size_t size() const { return m_Size; }
+	[[nodiscard]] bool empty() const { return m_Size == 0; }
+	[[nodiscard]] size_t capacity() const { return m_Capacity; }
+
+	TType& back() { return m_Data[m_Size - 1]; }
+	const TType& back() const { return m_Data[m_Size - 1]; }
+
+	template <typename... TArgs>
+	TType& emplace_back(TArgs&&... args) {
+		if (m_Size == m_Capacity) {
+			// The arguments may refer to an element, so the new one is made before the old ones are moved
+			TType obj(std::forward<TArgs>(args)...);
+			reallocate(m_Capacity * 2);
+			new (m_Data + m_Size) TType(std::move(obj));
+		} else {
+			new (m_Data + m_Size) TType(std::forward<TArgs>(args)...);
+		}
+		return m_Data[m_Size++];
+	}
+
+	void push_back(const TType& obj) { emplace_back(obj); }
+	void push_back(TType&& obj) { emplace_back(std::move(obj)); }
+
+	void pop_back() { std::destroy_at(m_Data + --m_Size); }
+
+	iterator erase(const_iterator position) {
+		const size_t index = position - m_Data;
+		popAt(index);
+		return m_Data + index;
+	}
+
+protected:
+
+	TType* getInline() { return reinterpret_cast<TType*>(m_Inline); }
+	const TType* getInline() const { return reinterpret_cast<const TType*>(m_Inline); }
+
+	// Expects to be empty, the memory reserved is freed again if a copy throws
+	void copyFrom(const TType* first, const size_t count) {
+		reserve(count);
+		try {
+			std::uninitialized_copy(first, first + count, m_Data);
+		} catch (...) {
+			deallocate();
+			throw;
+		}
+		m_Size = count;
+	}
+
+	void reallocate(const size_t capacity) {
+		TType* data = std::allocator<TType>().allocate(capacity);
+		try {
+			// Copied rather than moved when moving can throw, so a throwing copy leaves the elements as they were
+			if constexpr (std::is_nothrow_move_constructible_v<TType> || !std::is_copy_constructible_v<TType>) {
+				std::uninitialized_move(m_Data, m_Data + m_Size, data);
+			} else {
+				std::uninitialized_copy(m_Data, m_Data + m_Size, data);
+			}
+		} catch (...) {
+			std::allocator<TType>().deallocate(data, capacity);
+			throw;
+		}
+		std::destroy(m_Data, m_Data + m_Size);
+		deallocate();
+		m_Data = data;
+		m_Capacity = capacity;
+	}
+
+	void deallocate() {
+		if (!isInline()) {
+			std::allocator<TType>().deallocate(m_Data, m_Capacity);
+			m_Data = getInline();
+			m_Capacity = TSize;
+		}
+	}
+
+	alignas(TType) unsigned char m_Inline[sizeof(TType) * TSize];
+
+	TType* m_Data = getInline();
+	size_t m_Size = 0;
+	size_t m_Capacity = TSize;
+};
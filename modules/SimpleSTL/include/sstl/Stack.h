@@ -3,27 +3,34 @@
 #include "Deque.h"
 
 // std::stack is already a wrapper around a deque, so we do that here too, and skip std::stack's own abstraction
-template <typename TType>
-struct TStack : TDeque<TType> {
+template <typename TType, typename TAllocator = std::allocator<TType>>
+struct TStack : TDeque<TType, TAllocator> {
 
-	using TDeque<TType>::m_Container;
+	using TDeque<TType, TAllocator>::m_Container;
+
+	// Brings in the templated overloads, which would otherwise be hidden by the overrides below
+	using TDeque<TType, TAllocator>::forEach;
+	using TDeque<TType, TAllocator>::forEachReverse;
 	
 	TStack() = default;
 
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
-	TStack(TInitializerList<TType> init): TDeque<TType>(init) {}
+	TStack(TInitializerList<TType> init): TDeque<TType, TAllocator>(init) {}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
-	explicit TStack(TArgs&&... args): TDeque<TType>(std::forward<TArgs>(args)...) {}
+	explicit TStack(TArgs&&... args): TDeque<TType, TAllocator>(std::forward<TArgs>(args)...) {}
 	
-	TStack(const std::deque<TType>& otr): TDeque<TType>::m_Container(otr) {}
+	TStack(const std::deque<TType, TAllocator>& otr): TDeque<TType, TAllocator>::m_Container(otr) {}
+
+	explicit TStack(const TAllocator& allocator): TDeque<TType, TAllocator>(allocator) {}
 
 	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
-		const size_t previousSize = TDeque<TType>::getSize();
+		const size_t previousSize = TDeque<TType, TAllocator>::getSize();
 		for (size_t i = previousSize; i < amt; ++i) {
 			m_Container.emplace_front(std::forward<TType>(func(i)));
 		}
@@ -31,7 +38,7 @@ struct TStack : TDeque<TType> {
 
 	virtual TType& push() override {
 		m_Container.emplace_front();
-		return TDeque<TType>::top();
+		return TDeque<TType, TAllocator>::top();
 	}
 
 	virtual size_t push(const TType& obj) override {
@@ -54,8 +61,8 @@ struct TStack : TDeque<TType> {
 
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
-			TDeque<TType>::popAt(index);
-			TDeque<TType>::push(index, obj);
+			TDeque<TType, TAllocator>::popAt(index);
+			TDeque<TType, TAllocator>::push(index, obj);
 		} else {
 			throw std::runtime_error("Type is not copyable");
 		}
@@ -63,15 +70,15 @@ struct TStack : TDeque<TType> {
 
 	virtual void replace(const size_t index, TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
-			TDeque<TType>::popAt(index);
-			TDeque<TType>::push(index, std::move(obj));
+			TDeque<TType, TAllocator>::popAt(index);
+			TDeque<TType, TAllocator>::push(index, std::move(obj));
 		} else {
 			throw std::runtime_error("Type is not moveable");
 		}
 	}
 
 	virtual void pop() override {
-		TDeque<TType>::popAt(static_cast<size_t>(0));
+		TDeque<TType, TAllocator>::popAt(static_cast<size_t>(0));
 	}
 
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
@@ -89,14 +96,14 @@ struct TStack : TDeque<TType> {
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
-		size_t i = TDeque<TType>::getSize() - 1;
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
-		size_t i = TDeque<TType>::getSize() - 1;
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
@@ -105,33 +112,38 @@ struct TStack : TDeque<TType> {
 protected:
 
 	virtual TType& bottom() override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual const TType& bottom() const override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual TType& get(size_t index) override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual const TType& get(size_t index) const override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual void push(const size_t index, const TType& obj) override {
-		TDeque<TType>::push(index, obj);
+		TDeque<TType, TAllocator>::push(index, obj);
 	}
 
 	virtual void push(const size_t index, TType&& obj) override {
-		TDeque<TType>::push(index, std::move(obj));
+		TDeque<TType, TAllocator>::push(index, std::move(obj));
 	}
 
 	virtual void popAt(const size_t index) override {
-		TDeque<TType>::popAt(index);
+		TDeque<TType, TAllocator>::popAt(index);
 	}
 };
 
 template <typename TType, typename... TArgs>
 TStack(TType, TArgs...) -> TStack<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TStack = ::TStack<TType, std::pmr::polymorphic_allocator<TType>>;
+}
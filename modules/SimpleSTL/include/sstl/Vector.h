@@ -2,9 +2,10 @@
 
 #include <vector>
 #include "Container.h"
+#include "Execution.h"
 #include "sutil/InitializerList.h"
 
-template <typename TType>
+template <typename TType, typename TAllocator = std::allocator<TType>>
 struct TVector : TSequenceContainer<TType> {
 
 	_CONSTEXPR20 TVector() = default;
@@ -14,17 +15,23 @@ struct TVector : TSequenceContainer<TType> {
 	>
 	_CONSTEXPR20 TVector(TInitializerList<TType> init): m_Container(init) {}
 
+	// Kept from taking an allocator, which goes to the constructor below
 	template <typename... TArgs,
-		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>..., std::negation<std::is_convertible<TArgs, TAllocator>>...>, int> = 0
 	>
 	_CONSTEXPR20 explicit TVector(TArgs&&... args) {
 		m_Container.reserve(sizeof...(TArgs));
 		(m_Container.emplace_back(std::forward<TArgs>(args)), ...);
 	}
 
-	_CONSTEXPR20 TVector(const std::vector<TType>& otr): m_Container(otr) {}
+	_CONSTEXPR20 TVector(const std::vector<TType, TAllocator>& otr): m_Container(otr) {}
 
-	[[nodiscard]] virtual size_t getSize() const override {
+	// Every element, along with any memory the container needs for them, comes from the allocator, such as an arena through sstl::pmr
+	_CONSTEXPR20 explicit TVector(const TAllocator& allocator): m_Container(allocator) {}
+
+	[[nodiscard]] TAllocator getAllocator() const { return m_Container.get_allocator(); }
+
+	[[nodiscard]] virtual size_t getSize() const override STATIC_DISPATCH {
 		return m_Container.size();
 	}
 
@@ -32,19 +39,19 @@ struct TVector : TSequenceContainer<TType> {
 
 	const TType* data() const { return m_Container.data(); }
 
-	virtual TType& top() override {
+	virtual TType& top() override STATIC_DISPATCH {
 		return m_Container.front();
 	}
 
-	virtual const TType& top() const override {
+	virtual const TType& top() const override STATIC_DISPATCH {
 		return m_Container.front();
 	}
 
-	virtual TType& bottom() override {
+	virtual TType& bottom() override STATIC_DISPATCH {
 		return m_Container.back();
 	}
 
-	virtual const TType& bottom() const override {
+	virtual const TType& bottom() const override STATIC_DISPATCH {
 		return m_Container.back();
 	}
 
@@ -82,11 +89,19 @@ struct TVector : TSequenceContainer<TType> {
 		}
 	}
 
-	virtual TType& get(size_t index) override {
+	virtual TType& get(size_t index) override STATIC_DISPATCH {
+		return m_Container[index];
+	}
+
+	virtual const TType& get(size_t index) const override STATIC_DISPATCH {
 		return m_Container[index];
 	}
 
-	virtual const TType& get(size_t index) const override {
+	virtual TType& operator[](const size_t index) override STATIC_DISPATCH {
+		return m_Container[index];
+	}
+
+	virtual const TType& operator[](const size_t index) const override STATIC_DISPATCH {
 		return m_Container[index];
 	}
 
@@ -106,7 +121,7 @@ struct TVector : TSequenceContainer<TType> {
 		}
 	}
 
-	virtual void reserve(size_t amt) override {
+	virtual void reserve(size_t amt) override STATIC_DISPATCH {
 		m_Container.reserve(amt);
 	}
 
@@ -171,7 +186,7 @@ struct TVector : TSequenceContainer<TType> {
 		}
 	}
 
-	virtual void clear() override {
+	virtual void clear() override STATIC_DISPATCH {
 		m_Container.clear();
 	}
 
@@ -200,38 +215,184 @@ struct TVector : TSequenceContainer<TType> {
 		}
 	}
 
-	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
+	virtual void forEach(const std::function<void(size_t, TType&)>& func) override STATIC_DISPATCH {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override STATIC_DISPATCH {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override STATIC_DISPATCH {
+		size_t i = getSize() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override STATIC_DISPATCH {
+		size_t i = getSize() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	// Takes any callable rather than a std::function, so the call can be inlined into the loop
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
-	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
-	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
 		size_t i = getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
-	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
 		size_t i = getSize() - 1;
 		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
+	using TSequenceContainer<TType>::doFor;
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	// Overloads taking sstl::execution::seq, par or par_unseq, the parallel policies split the work between the threads of the shared pool
+	// Each element is given the same index as in the serial version, though the calls happen in no particular order
+	template <typename TPolicy, typename TFunc,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	void forEach(TPolicy&& policy, TFunc&& func) {
+		sstl::execution::forChunks(policy, m_Container.size(), [&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				func(i, m_Container[i]);
+			}
+		});
+	}
+
+	template <typename TPolicy, typename TFunc,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	void forEach(TPolicy&& policy, TFunc&& func) const {
+		sstl::execution::forChunks(policy, m_Container.size(), [&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				func(i, m_Container[i]);
+			}
+		});
+	}
+
+	// Always the first match, no matter which thread finds it
+	template <typename TPolicy,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	[[nodiscard]] size_t find(TPolicy&& policy, const TType& obj) const {
+		if constexpr (sutil::is_equality_comparable_v<TType>) {
+			return sstl::execution::findFirst(policy, m_Container.size(), [&](const size_t i) { return m_Container[i] == obj; });
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	template <typename TPolicy,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	[[nodiscard]] bool contains(TPolicy&& policy, const TType& obj) const {
+		return find(policy, obj) != m_Container.size();
+	}
+
+	// The new elements are default constructed up front, so each func(i) can be moved into its place from any thread
+	// Types that cannot be default constructed are always filled in serially
+	template <typename TPolicy, typename TFunc,
+		std::enable_if_t<sstl::execution::is_execution_policy_v<TPolicy>, int> = 0
+	>
+	void resize(TPolicy&& policy, const size_t amt, TFunc&& func) {
+		const size_t previousSize = getSize();
+		if constexpr (sstl::execution::is_parallel_policy_v<TPolicy> && std::is_default_constructible_v<TType> && std::is_move_assignable_v<TType>) {
+			if (amt <= previousSize) return;
+			m_Container.resize(amt);
+			try {
+				sstl::execution::forChunks(policy, amt - previousSize, [&](const size_t begin, const size_t end) {
+					for (size_t i = previousSize + begin; i < previousSize + end; ++i) {
+						m_Container[i] = func(i);
+					}
+				});
+			} catch (...) {
+				m_Container.resize(previousSize);
+				throw;
+			}
+		} else {
+			m_Container.reserve(amt);
+			for (size_t i = previousSize; i < amt; ++i) {
+				m_Container.emplace_back(func(i));
+			}
+		}
+	}
+
+	// Iterators of the underlying container, so it can be used with range-for and the standard algorithms
+	using value_type = typename std::vector<TType, TAllocator>::value_type;
+	using iterator = typename std::vector<TType, TAllocator>::iterator;
+	using const_iterator = typename std::vector<TType, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::vector<TType, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::vector<TType, TAllocator>::const_reverse_iterator;
+
+	iterator begin() { return m_Container.begin(); }
+	const_iterator begin() const { return m_Container.begin(); }
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	iterator end() { return m_Container.end(); }
+	const_iterator end() const { return m_Container.end(); }
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
 protected:
 
-	std::vector<TType> m_Container;
+	std::vector<TType, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
 TVector(TType, TArgs...) -> TVector<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+namespace sstl::pmr {
+	template <typename TType>
+	using TVector = ::TVector<TType, std::pmr::polymorphic_allocator<TType>>;
+}
@@ -0,0 +1,878 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sutil/Hashing.h"
+#include "sstl/Vector.h"
+#include "sstl/SmallVector.h"
+#include "sstl/Array.h"
+#include "sstl/Deque.h"
+#include "sstl/List.h"
+#include "sstl/ForwardList.h"
+#include "sstl/PrioritySet.h"
+#include "sstl/PriorityMap.h"
+#include "sstl/FlatPrioritySet.h"
+#include "sstl/FlatPriorityMap.h"
+#include "sstl/Set.h"
+#include "sstl/Map.h"
+#include "sstl/FlatSet.h"
+#include "sstl/FlatMap.h"
+#include "sstl/SlotMap.h"
+#include "sstl/Queue.h"
+#include "sstl/ConcurrentQueue.h"
+#include "sutil/Archive.h"
+#include "sutil/Threading.h"
+#include "sptr/Memory.h"
+#include "sptr/ObjectPool.h"
+
+/*
+ * Compares loops over the containers to the same loops over std::vector
+ * Build with SIMPLESTL_STATIC_DISPATCH to see the difference devirtualizing the hot path makes
+ */
+
+using namespace std::chrono;
+
+constexpr size_t CONTAINER_SIZE = 10000000;
+constexpr size_t ARRAY_SIZE = 1000000;
+
+// Keeps the compiler from removing loops whose results are never used
+static volatile int64_t sink = 0;
+
+template <typename TFunc>
+void run(const std::string& name, const size_t elementCount, TFunc&& func, const size_t repeats = 5) {
+    double best = 0.0;
+    for (size_t i = 0; i < repeats; ++i) {
+        const auto start = steady_clock::now();
+        sink = sink + func();
+        const double milliseconds = duration<double, std::milli>(steady_clock::now() - start).count();
+        if (i == 0 || milliseconds < best) best = milliseconds;
+    }
+    std::cout << name << ": " << best << "ms (" << best * 1000000.0 / static_cast<double>(elementCount) << "ns per element)" << std::endl;
+}
+
+// Hashed through getHash like any other key, rather than with std::hash
+struct SKey {
+    size_t id = 0;
+
+    friend bool operator==(const SKey& fst, const SKey& snd) { return fst.id == snd.id; }
+
+    friend size_t getHash(const SKey& key) { return key.id; }
+
+    friend CHashArchive& operator<<(CHashArchive& archive, const SKey& key) {
+        archive += key.id;
+        return archive;
+    }
+
+    friend CInputArchive& operator>>(CInputArchive& archive, SKey& key) { return archive >> key.id; }
+
+    friend COutputArchive& operator<<(COutputArchive& archive, const SKey& key) { return archive << key.id; }
+};
+
+// Keeps track of how much the containers given it are holding on to
+struct CCountingResource : std::pmr::memory_resource {
+    size_t bytes = 0;
+
+protected:
+    void* do_allocate(const size_t size, const size_t alignment) override {
+        bytes += size;
+        return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+
+    void do_deallocate(void* memory, const size_t size, const size_t alignment) override {
+        bytes -= size;
+        std::pmr::new_delete_resource()->deallocate(memory, size, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Pushes keys in a random order, then looks each of them up along with as many that were never pushed
+template <typename TContainer, typename TPushFunc>
+void compareHashed(const std::string& name, const std::vector<SKey>& keys, TPushFunc&& push) {
+    run(name + " push", keys.size(), [&] {
+        TContainer container;
+        for (const SKey& key : keys) push(container, key);
+        return static_cast<int64_t>(container.getSize());
+    }, 3);
+
+    CCountingResource resource;
+    {
+        TContainer container(&resource);
+        for (const SKey& key : keys) push(container, key);
+
+        run(name + " contains (hit)", keys.size(), [&] {
+            int64_t found = 0;
+            for (const SKey& key : keys) found += container.contains(key);
+            return found;
+        });
+
+        run(name + " contains (miss)", keys.size(), [&] {
+            int64_t found = 0;
+            for (const SKey& key : keys) found += container.contains(SKey{~key.id});
+            return found;
+        });
+
+        std::cout << name << " memory: " << static_cast<double>(resource.bytes) / static_cast<double>(keys.size()) << " bytes per entry" << std::endl;
+    }
+}
+
+// Holds everything written to it in memory, reading it back from the start after each rewind
+struct CMemoryArchive : CArchive {
+    void rewind() { m_Position = 0; }
+
+protected:
+    void read(void* inValue, const size_t inElementSize, const size_t inCount) override {
+        std::memcpy(inValue, m_Data.data() + m_Position, inElementSize * inCount);
+        m_Position += inElementSize * inCount;
+    }
+
+    void write(const void* inValue, const size_t inElementSize, const size_t inCount) override {
+        const auto* bytes = static_cast<const char*>(inValue);
+        m_Data.insert(m_Data.end(), bytes, bytes + inElementSize * inCount);
+    }
+
+private:
+    std::vector<char> m_Data;
+    size_t m_Position = 0;
+};
+
+// Fills the container one push at a time, then all at once with pushRange, then by loading it from an archive
+// Each run copies the pairs first, since pushRange moves out of them and may sort them in place
+template <typename TContainer, typename TKeyType>
+void compareBulk(const std::string& name, const std::vector<TPair<TKeyType, int>>& pairs, const bool comparePush = true) {
+    if (comparePush) {
+        run(name + " push", pairs.size(), [&] {
+            std::vector<TPair<TKeyType, int>> copy = pairs;
+            TContainer container;
+            for (auto& pair : copy) container.push(std::move(pair));
+            return static_cast<int64_t>(container.getSize());
+        }, 3);
+    }
+
+    run(name + " pushRange", pairs.size(), [&] {
+        std::vector<TPair<TKeyType, int>> copy = pairs;
+        TContainer container;
+        container.pushRange(copy.data(), copy.size());
+        return static_cast<int64_t>(container.getSize());
+    }, 3);
+
+    CMemoryArchive archive;
+    {
+        TContainer container;
+        std::vector<TPair<TKeyType, int>> copy = pairs;
+        container.pushRange(copy.data(), copy.size());
+        archive << static_cast<const TAssociativeContainer<TKeyType, int>&>(container);
+    }
+
+    run(name + " load", pairs.size(), [&] {
+        archive.rewind();
+        TContainer container;
+        archive >> static_cast<TAssociativeContainer<TKeyType, int>&>(container);
+        return static_cast<int64_t>(container.getSize());
+    }, 3);
+}
+
+// Small enough that the control block of a separately allocated one would often land on another cache line
+struct SPayload {
+    int64_t value = 0;
+    int64_t padding[3] = {};
+
+    SPayload() = default;
+    explicit SPayload(const int64_t value): value(value) {}
+};
+
+// Carries its own reference count, right beside the value it guards
+struct SCountedPayload : SPayload, TRefCounted<SCountedPayload> {
+    using SPayload::SPayload;
+};
+
+// Creates and frees shared pointers one way, then scans a shuffled vector of them, both reading through them and copying them
+template <typename TMakeFunc>
+void compareShared(const std::string& name, const size_t elementCount, TMakeFunc&& make) {
+    using TPointer = decltype(make(int64_t{}));
+
+    run(name + " create", elementCount, [&] {
+        TVector<TPointer> pointers;
+        pointers.reserve(elementCount);
+        for (size_t i = 0; i < elementCount; ++i) pointers.push(make(static_cast<int64_t>(i)));
+        return static_cast<int64_t>(pointers.getSize());
+    }, 3);
+
+    TVector<TPointer> pointers;
+    pointers.reserve(elementCount);
+    for (size_t i = 0; i < elementCount; ++i) pointers.push(make(static_cast<int64_t>(i)));
+
+    // Visited out of order, so every access is a cache miss rather than a walk through memory the allocator handed out in order
+    std::mt19937_64 random(elementCount);
+    std::shuffle(pointers.begin(), pointers.end(), random);
+
+    run(name + " scan", elementCount, [&] {
+        int64_t sum = 0;
+        for (size_t i = 0; i < pointers.getSize(); ++i) sum += pointers[i]->value;
+        return sum;
+    });
+
+    // Copying touches the reference count, which lives in the control block
+    run(name + " copy scan", elementCount, [&] {
+        int64_t sum = 0;
+        for (size_t i = 0; i < pointers.getSize(); ++i) {
+            const TPointer copy = pointers[i];
+            sum += copy->value;
+        }
+        return sum;
+    });
+}
+
+// Splits the operations between the threads, each calling func with its share of the values
+// Every thread pushes before it pops, so the queues never hold more than a batch per thread
+template <typename TFunc>
+int64_t contend(const size_t threadCount, const size_t operationCount, TFunc&& func) {
+    std::atomic<int64_t> total{0};
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < threadCount; ++thread) {
+        threads.emplace_back([&, thread] {
+            int64_t sum = 0;
+            for (size_t value = thread; value < operationCount; value += threadCount) sum += func(static_cast<int>(value));
+            total += sum;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    return total.load();
+}
+
+// Replaces a random one of a window of live objects on every step, so frees come back in no particular order, as they would in a running program
+template <typename TMakeFunc>
+int64_t churn(const size_t windowSize, const size_t operationCount, const size_t seed, TMakeFunc&& make) {
+    using TPointer = decltype(make(int64_t{}));
+
+    std::vector<TPointer> live;
+    live.reserve(windowSize);
+    for (size_t i = 0; i < windowSize; ++i) live.emplace_back(nullptr);
+
+    std::mt19937_64 random(seed);
+    int64_t sum = 0;
+    for (size_t i = 0; i < operationCount; ++i) {
+        TPointer& slot = live[random() % windowSize];
+        if (slot) sum += slot->value;
+        slot = make(static_cast<int64_t>(i));
+    }
+    return sum;
+}
+
+// Times every replacement on its own, since the average hides the slow ones that have to go to the system for more memory
+template <typename TMakeFunc>
+void comparePooled(const std::string& name, const size_t operationCount, TMakeFunc&& make) {
+    using TPointer = decltype(make(int64_t{}));
+    constexpr size_t WINDOW_SIZE = 10000;
+
+    run(name + " churn", operationCount, [&] {
+        return churn(WINDOW_SIZE, operationCount, operationCount, make);
+    }, 3);
+
+    // The same amount of work split between threads, which all share the allocator
+    for (size_t threadCount : {2, 4, 8}) {
+        run(name + " churn (" + std::to_string(threadCount) + " threads)", operationCount, [&] {
+            std::atomic<int64_t> total{0};
+            std::vector<std::thread> threads;
+            for (size_t thread = 0; thread < threadCount; ++thread) {
+                threads.emplace_back([&, thread] {
+                    total += churn(WINDOW_SIZE, operationCount / threadCount, thread, make);
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            return total.load();
+        }, 3);
+    }
+
+    std::vector<TPointer> live;
+    live.reserve(WINDOW_SIZE);
+    for (size_t i = 0; i < WINDOW_SIZE; ++i) live.emplace_back(make(static_cast<int64_t>(i)));
+
+    std::vector<double> latencies(operationCount);
+    std::mt19937_64 random(operationCount);
+    for (size_t i = 0; i < operationCount; ++i) {
+        TPointer& slot = live[random() % WINDOW_SIZE];
+        const auto start = steady_clock::now();
+        slot = make(static_cast<int64_t>(i));
+        latencies[i] = duration<double, std::nano>(steady_clock::now() - start).count();
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    const auto percentile = [&](const double fraction) { return latencies[static_cast<size_t>(fraction * static_cast<double>(operationCount - 1))]; };
+    std::cout << name << " latency: " << percentile(0.5) << "ns p50, " << percentile(0.99) << "ns p99, " << percentile(0.999) << "ns p99.9, " << latencies.back() << "ns max" << std::endl;
+}
+
+// The std::function overload is only picked through a const reference when given a matching std::function, just as it was before the templated overloads
+template <typename TContainer>
+void compareSequenceForEach(const std::string& name, const TContainer& container, const size_t elementCount) {
+    run(name + " forEach (std::function)", elementCount, [&] {
+        int64_t sum = 0;
+        const std::function<void(size_t, const int&)> func = [&](size_t, const int& value) { sum += value; };
+        container.forEach(func);
+        return sum;
+    });
+
+    run(name + " forEach (template)", elementCount, [&] {
+        int64_t sum = 0;
+        container.forEach([&](size_t, const int& value) { sum += value; });
+        return sum;
+    });
+}
+
+int main() {
+
+#ifdef SIMPLESTL_STATIC_DISPATCH
+    std::cout << "Static dispatch is on" << std::endl << std::endl;
+#else
+    std::cout << "Static dispatch is off" << std::endl << std::endl;
+#endif
+
+    {
+        std::vector<int> stdVector(CONTAINER_SIZE);
+        std::iota(stdVector.begin(), stdVector.end(), 0);
+
+        // Held the same way as the array, so both are reached through a pointer like most long lived containers
+        const auto vectorPointer = std::make_unique<TVector<int>>(stdVector);
+        TVector<int>& vector = *vectorPointer;
+
+        std::cout << "Sum of " << CONTAINER_SIZE << " elements" << std::endl;
+
+        run("std::vector operator[]", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < stdVector.size(); ++i) sum += stdVector[i];
+            return sum;
+        });
+
+        run("TVector get", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < vector.getSize(); ++i) sum += vector.get(i);
+            return sum;
+        });
+
+        run("TVector operator[]", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < vector.getSize(); ++i) sum += vector[i];
+            return sum;
+        });
+
+        compareSequenceForEach("TVector", vector, CONTAINER_SIZE);
+
+        run("TVector doFor (template)", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            vector.doFor(0, vector.getSize(), [&](size_t, const int& value) { sum += value; });
+            return sum;
+        });
+
+        std::cout << std::endl << "Push of " << CONTAINER_SIZE << " elements" << std::endl;
+
+        run("std::vector push_back", CONTAINER_SIZE, [&] {
+            std::vector<int> pushed;
+            pushed.reserve(CONTAINER_SIZE);
+            for (size_t i = 0; i < CONTAINER_SIZE; ++i) pushed.push_back(static_cast<int>(i));
+            return static_cast<int64_t>(pushed.size());
+        });
+
+        run("TVector push", CONTAINER_SIZE, [&] {
+            TVector<int> pushed;
+            pushed.reserve(CONTAINER_SIZE);
+            for (size_t i = 0; i < CONTAINER_SIZE; ++i) pushed.push(static_cast<int>(i));
+            return static_cast<int64_t>(pushed.getSize());
+        });
+    }
+
+    {
+        const auto vectorPointer = std::make_unique<TVector<int>>();
+        TVector<int>& vector = *vectorPointer;
+
+        std::cout << std::endl << "Execution policies over " << CONTAINER_SIZE << " elements on " << CThreadPool::get().getThreadCount() << " threads" << std::endl;
+
+        // Expensive enough per element that the split is worth it
+        const auto fill = [](const size_t index) {
+            int value = static_cast<int>(index);
+            for (int i = 0; i < 32; ++i) value = value * 1103515245 + 12345;
+            return value;
+        };
+
+        run("TVector resize (seq)", CONTAINER_SIZE, [&] {
+            vector.clear();
+            vector.resize(sstl::execution::seq, CONTAINER_SIZE, fill);
+            return static_cast<int64_t>(vector.getSize());
+        });
+
+        run("TVector resize (par)", CONTAINER_SIZE, [&] {
+            vector.clear();
+            vector.resize(sstl::execution::par, CONTAINER_SIZE, fill);
+            return static_cast<int64_t>(vector.getSize());
+        });
+
+        run("TVector forEach (seq)", CONTAINER_SIZE, [&] {
+            vector.forEach(sstl::execution::seq, [&](size_t index, int& value) { value = fill(index); });
+            return static_cast<int64_t>(vector[0]);
+        });
+
+        run("TVector forEach (par)", CONTAINER_SIZE, [&] {
+            vector.forEach(sstl::execution::par, [&](size_t index, int& value) { value = fill(index); });
+            return static_cast<int64_t>(vector[0]);
+        });
+
+        // Only the last element matches, so the whole vector is searched
+        vector[CONTAINER_SIZE - 1] = 0;
+        for (size_t i = 0; i + 1 < CONTAINER_SIZE; ++i) if (vector[i] == 0) vector[i] = 1;
+
+        run("TVector find (seq)", CONTAINER_SIZE, [&] { return static_cast<int64_t>(vector.find(sstl::execution::seq, 0)); });
+        run("TVector find (par)", CONTAINER_SIZE, [&] { return static_cast<int64_t>(vector.find(sstl::execution::par, 0)); });
+        run("TVector contains (seq)", CONTAINER_SIZE, [&] { return static_cast<int64_t>(vector.contains(sstl::execution::seq, -1)); });
+        run("TVector contains (par)", CONTAINER_SIZE, [&] { return static_cast<int64_t>(vector.contains(sstl::execution::par, -1)); });
+    }
+
+    {
+        constexpr size_t LIST_COUNT = CONTAINER_SIZE / 4;
+
+        std::cout << std::endl << "Fill " << LIST_COUNT << " lists of 4 elements" << std::endl;
+
+        run("TVector lists", CONTAINER_SIZE, [&] {
+            std::vector<TVector<int>> lists(LIST_COUNT);
+            for (size_t i = 0; i < LIST_COUNT; ++i)
+                for (int j = 0; j < 4; ++j) lists[i].push(j);
+            return static_cast<int64_t>(lists.back().getSize());
+        }, 3);
+
+        // Every list fits inline, so the only allocation is the outer vector
+        run("TSmallVector<4> lists", CONTAINER_SIZE, [&] {
+            std::vector<TSmallVector<int, 4>> lists(LIST_COUNT);
+            for (size_t i = 0; i < LIST_COUNT; ++i)
+                for (int j = 0; j < 4; ++j) lists[i].push(j);
+            return static_cast<int64_t>(lists.back().getSize());
+        }, 3);
+    }
+
+    {
+        constexpr size_t FRAME_COUNT = 1000;
+        constexpr size_t FRAME_ELEMENTS = 1000;
+
+        std::cout << std::endl << "Frame scoped containers over " << FRAME_COUNT << " frames" << std::endl;
+
+        // Built up and thrown away each frame, the way per frame or per request data usually is
+        const auto frame = [](auto& vector, auto& list, auto& map) {
+            int64_t sum = 0;
+            for (size_t i = 0; i < FRAME_ELEMENTS; ++i) {
+                vector.push(static_cast<int>(i));
+                list.push(static_cast<int>(i));
+                map.push(static_cast<int>(i), static_cast<int>(i));
+            }
+            vector.forEach([&](size_t, const int& value) { sum += value; });
+            return sum;
+        };
+
+        run("Default allocator", FRAME_COUNT * FRAME_ELEMENTS, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < FRAME_COUNT; ++i) {
+                TVector<int> vector;
+                TList<int> list;
+                TPriorityMap<int, int> map;
+                sum += frame(vector, list, map);
+            }
+            return sum;
+        }, 3);
+
+        // Large enough for a whole frame, so releasing the arena just rewinds it and nothing is allocated at all
+        std::vector<std::byte> buffer(1 << 20);
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+
+        run("Monotonic arena", FRAME_COUNT * FRAME_ELEMENTS, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < FRAME_COUNT; ++i) {
+                {
+                    sstl::pmr::TVector<int> vector(&arena);
+                    sstl::pmr::TList<int> list(&arena);
+                    sstl::pmr::TPriorityMap<int, int> map(&arena);
+                    sum += frame(vector, list, map);
+                }
+                arena.release();
+            }
+            return sum;
+        }, 3);
+    }
+
+    {
+        constexpr size_t KEY_COUNT = 1000000;
+
+        // Random ids, as sequential ones would let the node based containers place every key in a bucket of its own
+        std::mt19937_64 random(KEY_COUNT);
+        std::vector<SKey> keys(KEY_COUNT);
+        for (SKey& key : keys) key.id = random();
+
+        std::cout << std::endl << "Hashed containers with " << KEY_COUNT << " keys" << std::endl;
+
+        const auto pushSet = [](auto& set, const SKey& key) { set.push(key); };
+        const auto pushMap = [](auto& map, const SKey& key) { map.push(key, static_cast<int>(key.id)); };
+
+        // The pmr aliases, so the memory each container holds can be counted
+        compareHashed<sstl::pmr::TSet<SKey>>("TSet", keys, pushSet);
+        compareHashed<sstl::pmr::TFlatSet<SKey>>("TFlatSet", keys, pushSet);
+        compareHashed<sstl::pmr::TMap<SKey, int>>("TMap", keys, pushMap);
+        compareHashed<sstl::pmr::TFlatMap<SKey, int>>("TFlatMap", keys, pushMap);
+    }
+
+    {
+        constexpr size_t KEY_COUNT = 1000000;
+        constexpr int RANGE_WIDTH = 1000;
+
+        std::mt19937_64 random(KEY_COUNT);
+        std::vector<std::pair<int, int>> pairs(KEY_COUNT);
+        for (auto& pair : pairs) pair = {static_cast<int>(random() >> 33), 1};
+
+        std::cout << std::endl << "Ordered containers with " << KEY_COUNT << " keys" << std::endl;
+
+        run("TPriorityMap push", KEY_COUNT, [&] {
+            TPriorityMap<int, int> map;
+            for (const auto& pair : pairs) map.push(pair.first, pair.second);
+            return static_cast<int64_t>(map.getSize());
+        }, 3);
+
+        // Sorted once at the end, rather than kept sorted after every push
+        run("TFlatPriorityMap pushRange", KEY_COUNT, [&] {
+            TFlatPriorityMap<int, int> map;
+            map.pushRange(pairs.begin(), pairs.end());
+            return static_cast<int64_t>(map.getSize());
+        }, 3);
+
+        CCountingResource treeResource;
+        CCountingResource flatResource;
+        sstl::pmr::TPriorityMap<int, int> tree(&treeResource);
+        sstl::pmr::TFlatPriorityMap<int, int> flat(&flatResource);
+        for (const auto& pair : pairs) tree.push(pair.first, pair.second);
+        flat.pushRange(pairs.begin(), pairs.end());
+
+        run("TPriorityMap contains", KEY_COUNT, [&] {
+            int64_t found = 0;
+            for (const auto& pair : pairs) found += tree.contains(pair.first);
+            return found;
+        });
+
+        run("TFlatPriorityMap contains", KEY_COUNT, [&] {
+            int64_t found = 0;
+            for (const auto& pair : pairs) found += flat.contains(pair.first);
+            return found;
+        });
+
+        run("TPriorityMap forEach", KEY_COUNT, [&] {
+            int64_t sum = 0;
+            tree.forEach([&](TPair<int, const int&> pair) { sum += pair.second; });
+            return sum;
+        });
+
+        run("TFlatPriorityMap forEach", KEY_COUNT, [&] {
+            int64_t sum = 0;
+            flat.forEach([&](TPair<int, const int&> pair) { sum += pair.second; });
+            return sum;
+        });
+
+        // A thousand windows, each a thousandth of the key space wide
+        const int step = std::numeric_limits<int>::max() / RANGE_WIDTH;
+        run("TPriorityMap range (iterators)", KEY_COUNT, [&] {
+            int64_t sum = 0;
+            auto itr = tree.begin();
+            for (int window = 0; window < RANGE_WIDTH; ++window) {
+                for (; itr != tree.end() && itr->first < (window + 1) * step; ++itr) sum += itr->second;
+            }
+            return sum;
+        });
+
+        run("TFlatPriorityMap forRange", KEY_COUNT, [&] {
+            int64_t sum = 0;
+            for (int window = 0; window < RANGE_WIDTH; ++window) {
+                flat.forRange(window * step, (window + 1) * step, [&](TPair<int, const int&> pair) { sum += pair.second; });
+            }
+            return sum;
+        });
+
+        std::cout << "TPriorityMap memory: " << static_cast<double>(treeResource.bytes) / static_cast<double>(tree.getSize()) << " bytes per entry" << std::endl;
+        std::cout << "TFlatPriorityMap memory: " << static_cast<double>(flatResource.bytes) / static_cast<double>(flat.getSize()) << " bytes per entry" << std::endl;
+    }
+
+    {
+        constexpr size_t KEY_COUNT = 1000000;
+
+        std::mt19937_64 random(KEY_COUNT);
+        std::vector<TPair<int, int>> pairs(KEY_COUNT);
+        std::vector<TPair<SKey, int>> hashedPairs(KEY_COUNT);
+        for (size_t i = 0; i < KEY_COUNT; ++i) {
+            pairs[i] = {static_cast<int>(random() >> 33), static_cast<int>(i)};
+            hashedPairs[i] = {SKey{random()}, static_cast<int>(i)};
+        }
+
+        std::cout << std::endl << "Bulk loading " << KEY_COUNT << " pairs" << std::endl;
+
+        compareBulk<TPriorityMap<int, int>>("TPriorityMap", pairs);
+        // Each push shifts everything after it, which would take minutes at this size
+        compareBulk<TFlatPriorityMap<int, int>>("TFlatPriorityMap", pairs, false);
+        compareBulk<TMap<SKey, int>>("TMap", hashedPairs);
+        compareBulk<TFlatMap<SKey, int>>("TFlatMap", hashedPairs);
+
+        // Already in order, so the ordered containers can skip sorting them
+        std::vector<TPair<int, int>> sorted = pairs;
+        std::sort(sorted.begin(), sorted.end(), [](const TPair<int, int>& fst, const TPair<int, int>& snd) { return fst.first < snd.first; });
+
+        run("TPriorityMap pushRange (sorted)", KEY_COUNT, [&] {
+            std::vector<TPair<int, int>> copy = sorted;
+            TPriorityMap<int, int> map;
+            map.pushRange(copy.data(), copy.size(), true);
+            return static_cast<int64_t>(map.getSize());
+        }, 3);
+
+        run("TFlatPriorityMap pushRange (sorted)", KEY_COUNT, [&] {
+            std::vector<TPair<int, int>> copy = sorted;
+            TFlatPriorityMap<int, int> map;
+            map.pushRange(copy.data(), copy.size(), true);
+            return static_cast<int64_t>(map.getSize());
+        }, 3);
+    }
+
+    {
+        constexpr size_t POINTER_COUNT = 1000000;
+
+        std::cout << std::endl << "Shared pointers to " << POINTER_COUNT << " objects" << std::endl;
+
+        // The way TShared created its objects before, with the control block allocated apart from the object
+        compareShared("TShared (separate control block)", POINTER_COUNT, [](const int64_t value) {
+            return TShared<SPayload>(std::shared_ptr<SPayload>(new SPayload(value), sstl::deleter<SPayload>()));
+        });
+
+        compareShared("TShared (single allocation)", POINTER_COUNT, [](const int64_t value) {
+            return TShared<SPayload>(value);
+        });
+
+        // Counted with plain integers, so copies skip the atomic increment and decrement
+        compareShared("TLocalShared", POINTER_COUNT, [](const int64_t value) {
+            return TLocalShared<SPayload>(value);
+        });
+
+        // No control block at all, the count is read from the same cache line as the value
+        compareShared("TIntrusive", POINTER_COUNT, [](const int64_t value) {
+            return TIntrusive<SCountedPayload>(value);
+        });
+    }
+
+    {
+        constexpr size_t OPERATION_COUNT = 1000000;
+        constexpr size_t BATCH_SIZE = 16;
+
+        std::cout << std::endl << "Queues shared by threads, " << OPERATION_COUNT << " pushes and pops" << std::endl;
+
+        for (size_t threadCount = 1; threadCount <= 64; threadCount *= 2) {
+            const std::string threads = " (" + std::to_string(threadCount) + " threads)";
+
+            // Every push and pop takes the queue's mutex
+            run("TThreadSafe<TQueue>" + threads, OPERATION_COUNT, [&] {
+                TThreadSafe<TQueue<int>> queue;
+                return contend(threadCount, OPERATION_COUNT, [&](const int value) {
+                    queue->push(value);
+                    int popped = 0;
+                    queue.lockFor([&](TQueue<int>& locked) {
+                        if (locked.getSize() > 0) {
+                            popped = locked.top();
+                            locked.pop();
+                        }
+                    });
+                    return popped;
+                });
+            }, 3);
+
+            run("TConcurrentQueue" + threads, OPERATION_COUNT, [&] {
+                TConcurrentQueue<int> queue(1024);
+                return contend(threadCount, OPERATION_COUNT, [&](const int value) {
+                    while (!queue.tryPush(value)) std::this_thread::yield();
+                    // A pop can come back empty while another thread's push is still being published, so it is retried
+                    int popped = 0;
+                    while (!queue.tryPop(popped)) std::this_thread::yield();
+                    return popped;
+                });
+            }, 3);
+
+            // One claim for every batch, rather than one for every value
+            run("TConcurrentQueue batched" + threads, OPERATION_COUNT, [&] {
+                TConcurrentQueue<int> queue(BATCH_SIZE * 64);
+                return contend(threadCount, OPERATION_COUNT / BATCH_SIZE, [&](const int value) {
+                    int batch[BATCH_SIZE];
+                    for (size_t i = 0; i < BATCH_SIZE; ++i) batch[i] = value;
+                    for (size_t pushed = 0; pushed < BATCH_SIZE;) {
+                        const size_t count = queue.tryPushRange(batch + pushed, BATCH_SIZE - pushed);
+                        if (count == 0) std::this_thread::yield();
+                        pushed += count;
+                    }
+                    // Pops as many as it pushed, so the queue never holds more than a batch per thread
+                    for (size_t popped = 0; popped < BATCH_SIZE;) {
+                        const size_t count = queue.tryPopRange(batch + popped, BATCH_SIZE - popped);
+                        if (count == 0) std::this_thread::yield();
+                        popped += count;
+                    }
+                    int64_t sum = 0;
+                    for (size_t i = 0; i < BATCH_SIZE; ++i) sum += batch[i];
+                    return sum;
+                });
+            }, 3);
+        }
+    }
+
+    {
+        constexpr size_t HANDLE_COUNT = 1000000;
+
+        std::cout << std::endl << "Handles to " << HANDLE_COUNT << " objects" << std::endl;
+
+        TSlotMap<SPayload> slots;
+        TVector<SSlotHandle> handles;
+        TVector<TShared<SPayload>> owners;
+        TVector<TWeak<SPayload>> weaks;
+        for (size_t i = 0; i < HANDLE_COUNT; ++i) {
+            handles.push(slots.emplace(static_cast<int64_t>(i)));
+            owners.push(TShared<SPayload>(static_cast<int64_t>(i)));
+            weaks.push(owners[i]);
+        }
+
+        // Looked up out of order, as systems holding handles to each other would
+        std::mt19937_64 random(HANDLE_COUNT);
+        std::shuffle(handles.begin(), handles.end(), random);
+        std::shuffle(weaks.begin(), weaks.end(), random);
+
+        // Locking increments and decrements the atomic count in the control block
+        run("TWeak lock", HANDLE_COUNT, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < weaks.getSize(); ++i) {
+                if (const TShared<SPayload> locked = weaks[i].get()) sum += locked->value;
+            }
+            return sum;
+        });
+
+        // Reads the slot and then the element, which can miss the cache twice, but never writes to shared memory
+        run("TSlotMap find", HANDLE_COUNT, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < handles.getSize(); ++i) {
+                if (const SPayload* payload = slots.find(handles[i])) sum += payload->value;
+            }
+            return sum;
+        });
+
+        run("TShared iterate", HANDLE_COUNT, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < owners.getSize(); ++i) sum += owners[i]->value;
+            return sum;
+        });
+
+        // The objects themselves sit next to each other, rather than being reached through a pointer each
+        run("TSlotMap iterate", HANDLE_COUNT, [&] {
+            int64_t sum = 0;
+            for (const SPayload& payload : slots) sum += payload.value;
+            return sum;
+        });
+    }
+
+    {
+        constexpr size_t OPERATION_COUNT = 1000000;
+
+        std::cout << std::endl << "Pooled objects, " << OPERATION_COUNT << " frees and allocations" << std::endl;
+
+        comparePooled("TUnique", OPERATION_COUNT, [](const int64_t value) {
+            return TUnique<SPayload>(value);
+        });
+
+        TObjectPool<SPayload> pool;
+
+        comparePooled("TUnique (pooled)", OPERATION_COUNT, [&](const int64_t value) {
+            return TUnfurled<TUnique<SPayload>>::create(pool, value);
+        });
+
+        comparePooled("TShared", OPERATION_COUNT, [](const int64_t value) {
+            return TShared<SPayload>(value);
+        });
+
+        // Both the object and its control block come from pools
+        comparePooled("TShared (pooled)", OPERATION_COUNT, [&](const int64_t value) {
+            return TUnfurled<TShared<SPayload>>::create(pool, value);
+        });
+    }
+
+    std::cout << std::endl << "Sum of " << CONTAINER_SIZE << " elements" << std::endl;
+
+    {
+        TDeque<int> deque;
+        deque.resize(CONTAINER_SIZE, [](const size_t index) { return static_cast<int>(index); });
+        compareSequenceForEach("TDeque", deque, CONTAINER_SIZE);
+    }
+
+    {
+        TList<int> list;
+        list.resize(CONTAINER_SIZE, [](const size_t index) { return static_cast<int>(index); });
+        compareSequenceForEach("TList", list, CONTAINER_SIZE);
+    }
+
+    {
+        TForwardList<int> forwardList;
+        forwardList.resize(CONTAINER_SIZE, [](const size_t index) { return static_cast<int>(index); });
+        compareSequenceForEach("TForwardList", forwardList, CONTAINER_SIZE);
+    }
+
+    {
+        TPrioritySet<int> set;
+        for (size_t i = 0; i < CONTAINER_SIZE; ++i) set.push(static_cast<int>(i));
+
+        run("TPrioritySet forEach (std::function)", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            const std::function<void(const int&)> func = [&](const int& value) { sum += value; };
+            set.forEach(func);
+            return sum;
+        });
+
+        run("TPrioritySet forEach (template)", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            set.forEach([&](const int& value) { sum += value; });
+            return sum;
+        });
+    }
+
+    {
+        TPriorityMap<int, int> map;
+        for (size_t i = 0; i < CONTAINER_SIZE; ++i) map.push(static_cast<int>(i), static_cast<int>(i));
+
+        run("TPriorityMap forEach (std::function)", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            const std::function<void(TPair<int, const int&>)> func = [&](TPair<int, const int&> pair) { sum += pair.second; };
+            map.forEach(func);
+            return sum;
+        });
+
+        run("TPriorityMap forEach (template)", CONTAINER_SIZE, [&] {
+            int64_t sum = 0;
+            map.forEach([&](TPair<int, const int&> pair) { sum += pair.second; });
+            return sum;
+        });
+    }
+
+    {
+        // Too large for the stack
+        const auto array = std::make_unique<TArray<int, ARRAY_SIZE>>();
+        array->resize([](const size_t index) { return static_cast<int>(index); });
+
+        std::cout << std::endl << "Sum of " << ARRAY_SIZE << " elements" << std::endl;
+
+        run("TArray get", ARRAY_SIZE, [&] {
+            int64_t sum = 0;
+            for (size_t i = 0; i < array->getSize(); ++i) sum += array->get(i);
+            return sum;
+        });
+
+        compareSequenceForEach("TArray", *array, ARRAY_SIZE);
+    }
+
+    return 0;
+}
@@ -1,23 +1,42 @@
 ﻿#include <iostream>
 #include <random>
 #include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <numeric>
+#include <utility>
+
+#if CXX_VERSION >= 20
+#include <iterator>
+#include <ranges>
+#include <thread>
+#endif
 
 #include "sstl/Array.h"
 #include "sstl/Deque.h"
 #include "sstl/ForwardList.h"
 #include "sstl/Vector.h"
+#include "sstl/SmallVector.h"
 #include "sstl/MaxHeap.h"
 #include "sstl/MinHeap.h"
 #include "sstl/List.h"
 #include "sstl/MultiSet.h"
 #include "sstl/PriorityMultiSet.h"
 #include "sstl/Queue.h"
+#include "sstl/ConcurrentQueue.h"
 #include "sstl/Set.h"
+#include "sstl/FlatSet.h"
 #include "sstl/PrioritySet.h"
+#include "sstl/FlatPrioritySet.h"
 #include "sstl/Stack.h"
 #include "sstl/Map.h"
+#include "sstl/FlatMap.h"
+#include "sstl/SlotMap.h"
 #include "sptr/Memory.h"
+#include "sptr/ObjectPool.h"
 #include "sstl/PriorityMap.h"
+#include "sstl/FlatPriorityMap.h"
 #include "sstl/MultiMap.h"
 #include "sstl/PriorityMultiMap.h"
 
@@ -231,6 +250,17 @@ std::string enumToString(const MapEnum val) {
 	return "";
 }
 
+// Counts the init and destroy calls made on it by the smart pointers
+struct SLifetime {
+	explicit SLifetime(size_t& inInits, size_t& inDestroys): inits(inInits), destroys(inDestroys) {}
+
+	void init() { ++inits; }
+	void destroy() { ++destroys; }
+
+	size_t& inits;
+	size_t& destroys;
+};
+
 template <typename TType>
 #if CXX_VERSION >= 20
 requires std::is_base_of_v<Abstract, typename TUnfurled<TType>::Type>
@@ -370,6 +400,651 @@ void transferTest(const std::string& containerName, TAssociativeContainer<MapEnu
 	{ x container{TPair{MapEnum::NONE, TUnique{0}}, TPair{MapEnum::ONE, TUnique{5}}, TPair{MapEnum::TWO, TUnique{10}}}; container.forEach([](TPair<MapEnum, const TUnique<int>&> pair) { std::cout << *pair.second.get() << std::endl; }); } \
 
 
+#if CXX_VERSION >= 20
+// Each container should be usable anywhere the standard library expects a range
+static_assert(std::ranges::contiguous_range<TVector<int>>);
+static_assert(std::ranges::contiguous_range<TArray<int, 3>>);
+static_assert(std::ranges::contiguous_range<const TVector<int>>);
+static_assert(std::ranges::random_access_range<TDeque<int>>);
+static_assert(std::ranges::random_access_range<TQueue<int>>);
+static_assert(std::ranges::random_access_range<TStack<int>>);
+static_assert(std::ranges::random_access_range<TMinHeap<int>>);
+static_assert(std::is_same_v<std::ranges::range_reference_t<TMaxHeap<int>>, const int&>);
+static_assert(std::ranges::bidirectional_range<TList<int>>);
+static_assert(std::ranges::forward_range<TForwardList<int>>);
+static_assert(std::ranges::forward_range<TSet<Parent>>);
+static_assert(std::ranges::forward_range<TMultiSet<Parent>>);
+static_assert(std::ranges::forward_range<TFlatSet<Parent>>);
+static_assert(std::ranges::bidirectional_range<TPrioritySet<Parent>>);
+static_assert(std::ranges::bidirectional_range<TPriorityMultiSet<Parent>>);
+static_assert(std::ranges::contiguous_range<TFlatPrioritySet<Parent>>);
+static_assert(std::ranges::forward_range<TMap<MapEnum, Parent>>);
+static_assert(std::ranges::forward_range<TMultiMap<MapEnum, Parent>>);
+static_assert(std::ranges::forward_range<TFlatMap<MapEnum, Parent>>);
+static_assert(std::ranges::bidirectional_range<TPriorityMap<MapEnum, Parent>>);
+static_assert(std::ranges::bidirectional_range<TPriorityMultiMap<MapEnum, Parent>>);
+static_assert(std::ranges::contiguous_range<TFlatPriorityMap<MapEnum, Parent>>);
+#endif
+
+void iteratorTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Iterator Test" << std::endl;
+
+	TVector<int> vector{5, 3, 9, 1, 7};
+
+	std::sort(vector.begin(), vector.end());
+	assert(std::is_sorted(vector.begin(), vector.end()));
+	assert(std::accumulate(vector.begin(), vector.end(), 0) == 25);
+
+	for (const int& value : vector) {
+		std::cout << value << std::endl;
+	}
+
+#if CXX_VERSION >= 20
+	std::ranges::reverse(vector);
+	assert(std::ranges::is_sorted(vector, std::greater<>()));
+#endif
+
+	TList<int> list{1, 2, 3};
+	assert(std::find(list.begin(), list.end(), 2) != list.end());
+}
+
+// Both overloads of forEach should visit the same elements with the same indices, in the order of the container's iterators
+template <typename TContainer>
+void forEachOverloadTest(TContainer& container) {
+	const std::vector<int> expected(container.begin(), container.end());
+	std::vector<std::pair<size_t, int>> virtualVisits;
+	std::vector<std::pair<size_t, int>> templateVisits;
+
+	// Only a const std::function lvalue picks the virtual overload, any other callable goes to the templated one
+	const std::function<void(size_t, const int&)> func = [&](const size_t index, const int& value) { virtualVisits.emplace_back(index, value); };
+	std::as_const(container).forEach(func);
+	container.forEach([&](const size_t index, int& value) { templateVisits.emplace_back(index, value); });
+
+	assert(virtualVisits == templateVisits);
+	assert(templateVisits.size() == expected.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		assert(templateVisits[i].first == i);
+		assert(templateVisits[i].second == expected[i]);
+	}
+}
+
+template <typename TContainer>
+void forEachReverseOverloadTest(TContainer& container) {
+	const std::vector<int> expected(container.rbegin(), container.rend());
+	std::vector<std::pair<size_t, int>> virtualVisits;
+	std::vector<std::pair<size_t, int>> templateVisits;
+
+	const std::function<void(size_t, const int&)> func = [&](const size_t index, const int& value) { virtualVisits.emplace_back(index, value); };
+	std::as_const(container).forEachReverse(func);
+	container.forEachReverse([&](const size_t index, int& value) { templateVisits.emplace_back(index, value); });
+
+	assert(virtualVisits == templateVisits);
+	assert(templateVisits.size() == expected.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		assert(templateVisits[i].second == expected[i]);
+	}
+}
+
+void forEachTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "For Each Test" << std::endl;
+
+	TVector<int> vector{5, 3, 9, 1, 7};
+	TDeque<int> deque{5, 3, 9, 1, 7};
+	TList<int> list{5, 3, 9, 1, 7};
+	TForwardList<int> forwardList{5, 3, 9, 1, 7};
+	TArray<int, 5> array{5, 3, 9, 1, 7};
+
+	forEachOverloadTest(vector);
+	forEachOverloadTest(deque);
+	forEachOverloadTest(list);
+	forEachOverloadTest(forwardList);
+	forEachOverloadTest(array);
+
+	forEachReverseOverloadTest(vector);
+	forEachReverseOverloadTest(deque);
+	forEachReverseOverloadTest(list);
+	forEachReverseOverloadTest(array);
+
+	// Sorted containers visit in order through either overload
+	TPrioritySet<int> set{5, 3, 9, 1, 7};
+	std::vector<int> virtualVisits;
+	std::vector<int> templateVisits;
+	const std::function<void(const int&)> func = [&](const int& value) { virtualVisits.push_back(value); };
+	set.forEach(func);
+	set.forEach([&](const int& value) { templateVisits.push_back(value); });
+	assert(virtualVisits == templateVisits);
+	assert((templateVisits == std::vector<int>{1, 3, 5, 7, 9}));
+
+	TPriorityMap<int, int> map{TPair{2, 4}, TPair{1, 1}, TPair{3, 9}};
+	std::vector<std::pair<int, int>> virtualPairs;
+	std::vector<std::pair<int, int>> templatePairs;
+	const std::function<void(TPair<int, const int&>)> pairFunc = [&](TPair<int, const int&> pair) { virtualPairs.emplace_back(pair.first, pair.second); };
+	map.forEach(pairFunc);
+	map.forEach([&](TPair<int, const int&> pair) { templatePairs.emplace_back(pair.first, pair.second); });
+	assert(virtualPairs == templatePairs);
+	assert((templatePairs == std::vector<std::pair<int, int>>{{1, 1}, {2, 4}, {3, 9}}));
+
+	std::cout << "Visited the same elements through both overloads" << std::endl;
+}
+
+void parallelTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Parallel Test" << std::endl;
+
+	constexpr size_t size = 1000000;
+
+	// Every element lands at its own index, no matter which thread created it
+	TVector<size_t> vector;
+	vector.resize(sstl::execution::par, size, [](const size_t index) { return index * 2; });
+	assert(vector.getSize() == size);
+
+	std::atomic<size_t> mismatches{0};
+	vector.forEach(sstl::execution::par, [&](const size_t index, const size_t& value) {
+		if (value != index * 2) ++mismatches;
+	});
+	assert(mismatches == 0);
+
+	// The first match is found, even if a later one is found by another thread first
+	vector[size - 5] = 7;
+	vector[size - 1] = 7;
+	assert(vector.find(sstl::execution::par, 7) == size - 5);
+	assert(vector.find(sstl::execution::par, 7) == vector.find(sstl::execution::seq, 7));
+	assert(!vector.contains(sstl::execution::par_unseq, 3));
+
+	// Split down to single elements, so a small container still reaches every thread
+	TVector<size_t> small(0, 0, 0, 0, 0, 0, 0, 0);
+	small.forEach(sstl::execution::par.chunked(1), [](const size_t index, size_t& value) { value = index + 1; });
+	for (size_t i = 0; i < small.getSize(); ++i) {
+		assert(small[i] == i + 1);
+	}
+
+	// An array can't grow, so anything past its size is left out
+	TArray<size_t, 8> array;
+	array.resize(sstl::execution::par.chunked(2), 100, [](const size_t index) { return index; });
+	assert(array.getSize() == 8);
+	assert(array[7] == 7);
+
+	std::cout << "Filled and searched " << size << " elements on " << CThreadPool::get().getThreadCount() << " threads" << std::endl;
+}
+
+void allocatorTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Allocator Test" << std::endl;
+
+	std::byte buffer[4096];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+
+	{
+		sstl::pmr::TVector<int> vector(&arena);
+		sstl::pmr::TPriorityMap<int, int> map(&arena);
+		for (int i = 0; i < 10; ++i) {
+			vector.push(i);
+			map.push(i, i * i);
+		}
+
+		// Everything should have come out of the buffer
+		const auto* data = reinterpret_cast<const std::byte*>(vector.data());
+		assert(data >= buffer && data < buffer + sizeof(buffer));
+		assert(vector.getAllocator().resource() == &arena);
+		assert(map.get(3) == 9);
+
+		std::cout << "Filled a vector and a map from a " << sizeof(buffer) << " byte arena" << std::endl;
+	}
+
+	{
+		// A resource converts to bool and to void*, so these must pick the allocator constructor over the element one
+		sstl::pmr::TVector<const void*> pointers(&arena);
+		sstl::pmr::TDeque<bool> deque(&arena);
+		sstl::pmr::TList<bool> list(&arena);
+		sstl::pmr::TPrioritySet<bool> set(&arena);
+		sstl::pmr::TMinHeap<const void*> heap(&arena);
+		assert(pointers.getSize() == 0);
+		assert(deque.getSize() == 0);
+		assert(list.getSize() == 0);
+		assert(set.getSize() == 0);
+		assert(heap.getSize() == 0);
+		assert(pointers.getAllocator().resource() == &arena);
+		assert(deque.getAllocator().resource() == &arena);
+
+		deque.push(true);
+		assert(deque.getSize() == 1 && deque[0]);
+	}
+
+	// Nothing is freed until the arena is released, which frees it all at once
+	arena.release();
+}
+
+void flatTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Flat Test" << std::endl;
+
+	// Enough elements to grow past a single group of slots several times
+	TFlatSet<Parent> set;
+	for (size_t i = 0; i < 1000; ++i) {
+		set.push(Parent{i});
+	}
+	assert(set.getSize() == 1000);
+
+	// Every other element leaves a deleted slot behind, which must not hide the elements probed past it
+	for (size_t i = 0; i < 1000; i += 2) {
+		set.pop(Parent{i});
+	}
+	for (size_t i = 0; i < 1000; ++i) {
+		assert(set.contains(Parent{i}) == (i % 2 == 1));
+	}
+
+	const TFlatSet<Parent> copy = set;
+	for (size_t i = 1; i < 1000; i += 2) {
+		assert(copy.contains(Parent{i}));
+	}
+
+	// Clearing keeps the slots, so filling the set again doesn't have to grow it
+	const size_t capacity = set.getCapacity();
+	set.clear();
+	for (size_t i = 0; i < 500; ++i) {
+		set.push(Parent{i});
+	}
+	assert(set.getCapacity() == capacity);
+
+	TFlatMap<MapEnum, int> map;
+	map.push(MapEnum::ONE, 1);
+	map.push(MapEnum::TWO, 2);
+	map.replace(MapEnum::ONE, 10);
+	assert(map.get(MapEnum::ONE) == 10);
+	assert(std::distance(map.begin(), map.end()) == 2);
+
+	std::cout << "Set has " << set.getSize() << " elements in " << set.getCapacity() << " slots" << std::endl;
+}
+
+void flatPriorityTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Flat Priority Test" << std::endl;
+
+	// Taken in any order, sorted once, with the first of any equal elements kept
+	TFlatPrioritySet<int> set(std::vector<int>{9, 3, 7, 3, 1, 5});
+	assert(set.getSize() == 5);
+	assert(std::is_sorted(set.begin(), set.end()));
+
+	const std::vector<int> more{8, 2, 9, 4};
+	set.pushRange(more.begin(), more.end());
+	assert(set.getSize() == 8);
+	assert(std::is_sorted(set.begin(), set.end()));
+
+	// From 3 up to, but not including, 8
+	std::vector<int> range;
+	set.forRange(3, 8, [&](const int& i) { range.push_back(i); });
+	assert((range == std::vector<int>{3, 4, 5, 7}));
+	assert(set.countRange(3, 8) == 4);
+	assert(*set.lowerBound(6) == 7);
+	assert(*set.upperBound(7) == 8);
+
+	TFlatPriorityMap<int, std::string> map(std::vector<std::pair<int, std::string>>{{2, "two"}, {1, "one"}, {2, "again"}});
+	assert(map.getSize() == 2);
+	assert(map.get(2) == "two");
+	map.push(0, "zero");
+	assert(map.top().first == 0);
+	assert(map.countRange(1, 3) == 2);
+
+	std::cout << "Set holds";
+	set.forEach([](const int& i) { std::cout << " " << i; });
+	std::cout << std::endl;
+}
+
+void smallVectorTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Small Vector Test" << std::endl;
+
+	// Strings own memory of their own, so a bad copy or move between the inline and allocated storage shows up
+	const auto matches = [](const TSmallVector<std::string, 4>& vector, const size_t count) {
+		if (vector.getSize() != count) return false;
+		for (size_t i = 0; i < count; ++i) {
+			if (vector[i] != "element " + std::to_string(i)) return false;
+		}
+		return true;
+	};
+
+	TSmallVector<std::string, 4> vector;
+	for (size_t i = 0; i < 10; ++i) {
+		vector.push("element " + std::to_string(i));
+	}
+	assert(!vector.isInline());
+	assert(matches(vector, 10));
+
+	TSmallVector<std::string, 4> copy(vector);
+	assert(!copy.isInline());
+	assert(matches(copy, 10));
+
+	// Takes the allocated memory, leaving the other inline and empty
+	TSmallVector<std::string, 4> moved(std::move(copy));
+	assert(copy.isInline() && copy.getSize() == 0);
+	assert(matches(moved, 10));
+
+	// Back under the inline size, but still holding the memory it allocated
+	for (size_t i = 0; i < 8; ++i) {
+		vector.pop_back();
+	}
+	assert(!vector.isInline());
+	assert(matches(vector, 2));
+
+	// A copy only allocates if the elements don't fit inline
+	TSmallVector<std::string, 4> smallCopy(vector);
+	assert(smallCopy.isInline());
+	assert(matches(smallCopy, 2));
+
+	TSmallVector<std::string, 4> smallMoved(std::move(smallCopy));
+	assert(matches(smallMoved, 2));
+
+	// Assigning over an allocated vector reuses its memory, and the other way around allocates
+	moved = smallMoved;
+	assert(matches(moved, 2));
+	smallMoved = vector;
+	assert(matches(smallMoved, 2));
+	smallCopy = std::move(moved);
+	assert(matches(smallCopy, 2));
+	moved = std::move(smallMoved);
+	assert(matches(moved, 2));
+
+	std::cout << "Copied and moved across " << vector.getCapacity() << " allocated and 4 inline elements" << std::endl;
+}
+
+void bulkTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Bulk Test" << std::endl;
+
+	// Unsorted, with the first of any equal keys kept like pushing one at a time would
+	std::vector<TPair<int, std::string>> pairs{{3, "three"}, {1, "one"}, {3, "again"}, {2, "two"}};
+	TPriorityMap<int, std::string> map;
+	map.push(0, "zero");
+	map.pushRange(pairs.data(), pairs.size());
+	assert(map.getSize() == 4);
+	assert(map.get(3) == "three");
+
+	// Already sorted, so nothing is sorted again
+	std::vector<int> sorted{1, 2, 4, 8};
+	TFlatPrioritySet<int> set;
+	set.pushRange(sorted.data(), sorted.size(), true);
+	assert(set.getSize() == 4);
+	assert(std::is_sorted(set.begin(), set.end()));
+
+	// Equal elements keep the order they were given in
+	std::vector<TPair<int, int>> multi{{2, 0}, {1, 1}, {2, 2}};
+	TPriorityMultiMap<int, int> multiMap;
+	multiMap.pushRange(multi.data(), multi.size());
+	std::vector<int> order;
+	multiMap.forEach([&](TPair<int, const int&> pair) { order.push_back(pair.second); });
+	assert((order == std::vector<int>{1, 0, 2}));
+
+	// Build replaces whatever was there before
+	std::vector<int> rebuilt{5, 6};
+	set.build(rebuilt.data(), rebuilt.size());
+	assert(set.getSize() == 2);
+	assert(set.top() == 5);
+
+	std::cout << "Map holds";
+	map.forEach([](TPair<int, const std::string&> pair) { std::cout << " " << pair.second; });
+	std::cout << std::endl;
+}
+
+void sharedTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Shared Test" << std::endl;
+
+	size_t inits = 0;
+	size_t destroys = 0;
+
+	{
+		// Created in the same allocation as its control block, but still initialized and destroyed like before
+		TShared<SLifetime> shared(inits, destroys);
+		TWeak<SLifetime> weak = shared;
+		const TShared<SLifetime> copy = shared;
+		assert(inits == 1);
+
+		shared = nullptr;
+		assert(destroys == 0);
+		assert(weak);
+	}
+	assert(inits == 1);
+	assert(destroys == 1);
+
+	std::cout << "Initialized " << inits << " and destroyed " << destroys << std::endl;
+}
+
+void localSharedTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Local Shared Test" << std::endl;
+
+	struct SSelf : TLocalSharedFrom<SSelf> {};
+
+	size_t inits = 0;
+	size_t destroys = 0;
+
+	{
+		TLocalShared<SLifetime> shared(inits, destroys);
+		TLocalWeak<SLifetime> weak = shared;
+		{
+			const TLocalShared<SLifetime> copy = shared;
+			assert(shared.count() == 2);
+		}
+		assert(shared.count() == 1);
+		assert(inits == 1);
+
+		shared = nullptr;
+		assert(destroys == 1);
+		assert(!weak);
+		assert(!weak.get());
+	}
+	assert(inits == 1);
+	assert(destroys == 1);
+
+	{
+		// Non-const lvalues share the object, rather than being passed on to a new one
+		TLocalShared<SLifetime> shared(inits, destroys);
+		TLocalShared<SLifetime> copy(shared);
+		TLocalWeak<SLifetime> weak = shared;
+		TLocalShared<SLifetime> locked(weak);
+		assert(copy == shared);
+		assert(locked == shared);
+		assert(shared.count() == 3);
+		assert(inits == 2);
+	}
+	assert(destroys == 2);
+
+	{
+		TLocalShared<SSelf> self;
+		const TLocalShared<SSelf> other = self->getShared();
+		assert(other == self);
+		assert(self.count() == 2);
+	}
+
+	TVector<TLocalShared<size_t>> pointers;
+	for (size_t i = 0; i < 10; ++i) {
+		pointers.push(TUnfurled<TLocalShared<size_t>>::create(i));
+	}
+	assert(pointers.contains(pointers[4].get()));
+
+	std::cout << "Initialized " << inits << " and destroyed " << destroys << std::endl;
+}
+
+void intrusiveTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Intrusive Test" << std::endl;
+
+	struct SNode : TRefCounted<SNode> {
+		explicit SNode(const size_t inValue): value(inValue) {}
+
+		TIntrusive<SNode> getSelf() { return TIntrusive(this); }
+
+		size_t value;
+	};
+
+	static_assert(sizeof(TIntrusive<SNode>) == sizeof(SNode*));
+
+	{
+		TIntrusive<SNode> node(10);
+		assert(node->getRefCount() == 1);
+		{
+			// The count lives in the object, so a pointer made from this shares it
+			const TIntrusive<SNode> self = node->getSelf();
+			assert(self == node);
+			assert(node->getRefCount() == 2);
+		}
+		assert(node->getRefCount() == 1);
+
+		// Non-const lvalues add a reference, rather than being passed on to a new node
+		TIntrusive<SNode> copy(node);
+		assert(copy == node);
+		assert(node->getRefCount() == 2);
+	}
+
+	TVector<TIntrusive<SNode>> nodes;
+	for (size_t i = 0; i < 10; ++i) {
+		nodes.push(TUnfurled<TIntrusive<SNode>>::create(i));
+	}
+	assert(nodes.contains(nodes[4].get()));
+	assert(nodes.find(nodes[4].get()) == 4);
+
+	std::cout << "Found node " << nodes[nodes.find(nodes[4].get())]->value << std::endl;
+}
+
+void poolTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Pool Test" << std::endl;
+
+	size_t inits = 0;
+	size_t destroys = 0;
+
+	TObjectPool<SLifetime> pool;
+
+	{
+		// A freed block is the next one handed out
+		SLifetime* first = pool.create(inits, destroys);
+		TObjectPool<SLifetime>::free(first);
+		SLifetime* second = pool.create(inits, destroys);
+		assert(first == second);
+		TObjectPool<SLifetime>::free(second);
+	}
+
+	{
+		TUnique<SLifetime> unique = TUnfurled<TUnique<SLifetime>>::create(pool, inits, destroys);
+		TShared<SLifetime> shared = TUnfurled<TShared<SLifetime>>::create(pool, inits, destroys);
+		const TShared<SLifetime> copy = shared;
+
+		// Freed on another thread, which returns it straight to the pool
+		std::thread([moved = std::move(unique)]() mutable { moved = nullptr; }).join();
+		assert(destroys == 3);
+	}
+	assert(inits == 4);
+	assert(destroys == 4);
+
+	// Made before the thread's cache, so it is destroyed after it, and frees its object straight to the pool
+	std::thread([&] {
+		thread_local TUnique<SLifetime> holder;
+		holder = pool.makeUnique(inits, destroys);
+	}).join();
+	assert(inits == 5);
+	assert(destroys == 5);
+
+	std::cout << "Initialized " << inits << " and destroyed " << destroys << std::endl;
+}
+
+void slotMapTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Slot Map Test" << std::endl;
+
+	TSlotMap<std::string> map;
+	const SSlotHandle first = map.insert("first");
+	const SSlotHandle second = map.emplace("second");
+	const SSlotHandle third = map.insert("third");
+	assert(map.getSize() == 3);
+
+	// The last element is moved into the gap, but its handle still finds it
+	map.pop(first);
+	assert(!map.contains(first));
+	assert(map.find(first) == nullptr);
+	assert(map.get(third) == "third");
+
+	// The slot is reused, but the old handle doesn't match it
+	const SSlotHandle fourth = map.insert("fourth");
+	assert(fourth.index == first.index);
+	assert(!map.contains(first));
+	assert(map.get(fourth) == "fourth");
+
+	bool threw = false;
+	try {
+		map.push(first, "fifth");
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+	assert(threw);
+
+	map.forEach([&](TPair<SSlotHandle, const std::string&> pair) {
+		assert(map.get(pair.first) == pair.second);
+	});
+
+	TMap<SSlotHandle, std::string> other;
+	map.transfer(other, second);
+	assert(!map.contains(second));
+	assert(other.get(second) == "second");
+
+	std::cout << "Elements: ";
+	for (const std::string& obj : map) {
+		std::cout << obj << " ";
+	}
+	std::cout << std::endl;
+}
+
+void concurrentQueueTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Concurrent Queue Test" << std::endl;
+
+	// Rounded up to a power of two
+	TConcurrentQueue<std::string> strings(3);
+	assert(strings.getCapacity() == 4);
+
+	for (size_t i = 0; i < strings.getCapacity(); ++i) {
+		assert(strings.tryPush(std::to_string(i)));
+	}
+
+	// Nothing is moved from when the queue is full
+	std::string extra = "extra";
+	assert(!strings.tryPush(std::move(extra)));
+	assert(extra == "extra");
+
+	std::string popped;
+	assert(strings.tryPop(popped) && popped == "0");
+
+	std::string batch[4];
+	assert(strings.tryPopRange(batch, 4) == 3);
+	assert(batch[2] == "3");
+	assert(!strings.tryPop(popped));
+
+	constexpr size_t producerCount = 4;
+	constexpr size_t countPerProducer = 100000;
+
+	// Every value pushed is popped exactly once, whichever threads get to it
+	TConcurrentQueue<size_t> queue(256);
+	std::atomic<size_t> poppedCount{0};
+	std::atomic<size_t> poppedSum{0};
+	std::vector<std::thread> threads;
+
+	for (size_t producer = 0; producer < producerCount; ++producer) {
+		threads.emplace_back([&, producer] {
+			for (size_t value = producer * countPerProducer; value < (producer + 1) * countPerProducer;) {
+				if (queue.tryPush(value)) ++value;
+				else std::this_thread::yield();
+			}
+		});
+
+		threads.emplace_back([&] {
+			size_t values[16];
+			while (poppedCount < producerCount * countPerProducer) {
+				const size_t count = queue.tryPopRange(values, 16);
+				for (size_t i = 0; i < count; ++i) poppedSum += values[i];
+				poppedCount += count;
+				if (count == 0) std::this_thread::yield();
+			}
+		});
+	}
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	constexpr size_t total = producerCount * countPerProducer;
+	assert(poppedCount == total);
+	assert(poppedSum == total * (total - 1) / 2);
+
+	std::cout << "Passed " << total << " values between " << threads.size() << " threads" << std::endl;
+}
+
 int main() {
 	DO_TEST(TVector)
 	DO_TEST(TMaxHeap)
@@ -378,16 +1053,49 @@ int main() {
 	DO_TEST(TList)
 	DO_TEST(TForwardList)
 	DO_ARRAY_TEST(TArray)
+	DO_ARRAY_TEST(TSmallVector)
 	DO_TEST(TStack)
 	DO_TEST(TQueue)
 	DO_ASSOCIATIVE_TEST(TSet)
 	DO_ASSOCIATIVE_TEST(TMultiSet)
+	DO_ASSOCIATIVE_TEST(TFlatSet)
 	DO_ASSOCIATIVE_TEST(TPrioritySet)
 	DO_ASSOCIATIVE_TEST(TPriorityMultiSet)
+	DO_ASSOCIATIVE_TEST(TFlatPrioritySet)
 	DO_MAP_TEST(TMap)
 	DO_MAP_TEST(TMultiMap)
+	DO_MAP_TEST(TFlatMap)
 	DO_MAP_TEST(TPriorityMap)
 	DO_MAP_TEST(TPriorityMultiMap)
+	DO_MAP_TEST(TFlatPriorityMap)
+
+	iteratorTest();
+
+	forEachTest();
+
+	parallelTest();
+
+	allocatorTest();
+
+	flatTest();
+
+	flatPriorityTest();
+
+	smallVectorTest();
+
+	bulkTest();
+
+	concurrentQueueTest();
+
+	sharedTest();
+
+	localSharedTest();
+
+	intrusiveTest();
+
+	poolTest();
+
+	slotMapTest();
 
 	std::cout << std::endl;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #ifdef USING_SIMPLESTL
 #include "sstl/Container.h"
@@ -86,15 +87,16 @@ public:
 		return inArchive;
 	}
 
+	// Everything is read first and built in one go, so the container does not grow once per element
 	template <typename TType>
 	friend CInputArchive& operator>>(CInputArchive& inArchive, TSingleAssociativeContainer<TType>& inValue) {
 		size_t size;
 		inArchive >> size;
-		inValue.resize(size, [&] {
-			TType obj;
+		std::vector<TType> objs(size);
+		for (TType& obj : objs) {
 			inArchive >> obj;
-			return obj;
-		});
+		}
+		inValue.build(objs.data(), size);
 		return inArchive;
 	}
 
@@ -102,12 +104,12 @@ public:
 	friend CInputArchive& operator>>(CInputArchive& inArchive, TAssociativeContainer<TKeyType, TValueType>& inValue) {
 		size_t size;
 		inArchive >> size;
-		inValue.resize(size, [&] {
-			TPair<TKeyType, TValueType> pair;
-			inArchive >> pair.key;
-			inArchive >> pair.value;
-			return pair;
-		});
+		std::vector<TPair<TKeyType, TValueType>> pairs(size);
+		for (TPair<TKeyType, TValueType>& pair : pairs) {
+			inArchive >> pair.first;
+			inArchive >> pair.second;
+		}
+		inValue.build(pairs.data(), size);
 		return inArchive;
 	}
 #endif
@@ -189,8 +191,8 @@ public:
 	friend COutputArchive& operator<<(COutputArchive& inArchive, const TAssociativeContainer<TKeyType, TValueType>& inValue) {
 		inArchive << inValue.getSize();
 		inValue.forEach([&](TPair<TKeyType, const TValueType&> pair) {
-			inArchive << pair.key;
-			inArchive << pair.value;
+			inArchive << pair.first;
+			inArchive << pair.second;
 		});
 		return inArchive;
 	}